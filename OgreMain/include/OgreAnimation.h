@@ -443,7 +443,26 @@ namespace Ogre {
         
         /** Internal method used to tell the animation that keyframe list has been
             changed, which may cause it to rebuild some internal data */
-        void _keyFrameListChanged(void) { mKeyFrameTimesDirty = true; }
+        void _keyFrameListChanged(void);
+
+        /** Resamples the node tracks into a CompiledAnimation, which is used by
+            apply(Skeleton*, ...) from then on.
+
+            Applying the animation to a skeleton then does not search the keyframes and
+            interpolate the tracks one by one anymore, but interpolates the whole pose at once.
+            The compiled animation is discarded when tracks or keyframes are created or destroyed,
+            or when the length or the interpolation modes change. Changing the values of
+            existing keyframes requires compiling again.
+        @param sampleRate see CompiledAnimation
+        @param quantise see CompiledAnimation
+        */
+        void compile(Real sampleRate = 30, bool quantise = false);
+
+        /// The compiled node tracks, NULL if the animation is not compiled
+        const CompiledAnimation* getCompiled() const { return mCompiled.get(); }
+
+        /// Discards the compiled node tracks, so the tracks are evaluated directly again
+        void discardCompiled();
 
         /** Internal method used to convert time position to time index object.
         @note
@@ -526,6 +545,7 @@ namespace Ogre {
         Real mBaseKeyFrameTime;
         String mBaseKeyFrameAnimationName;
         AnimationContainer* mContainer;
+        std::unique_ptr<CompiledAnimation> mCompiled;
 
         void optimiseNodeTracks(bool discardIdentityTracks);
         void optimiseVertexTracks(void);
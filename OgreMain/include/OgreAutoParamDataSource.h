@@ -124,11 +124,41 @@ namespace Ogre {
         const SceneManager* mCurrentSceneManager;
         const VisibleObjectsBoundsInfo* mMainCamBoundsInfo;
         const Pass* mCurrentPass;
+        bool mUseIdentityView;
+        bool mUseIdentityProjection;
+
+        /// the version of every GpuParamSource
+        uint64 mVersions[GPS_COUNT];
+        /// the last version handed out, unique across all instances
+        uint64 mLastVersion;
 
         SceneNode mDummyNode;
         Light mBlankLight;
     public:
         AutoParamDataSource();
+
+        /** Mark the given sources as changed
+
+            Automatic parameters derived from them are updated on the next call to
+            GpuProgramParameters::_updateAutoParams. The setters of this class do this
+            automatically, but data which is queried on demand (e.g. the lights) is only
+            tracked per camera.
+            @param sources A mask of GpuParamSource
+        */
+        void _markDirty(uint8 sources);
+        /** The version of the given sources, which changes whenever any of them changed
+            @param sources A mask of GpuParamSource
+        */
+        uint64 getVersion(uint8 sources) const
+        {
+            uint64 version = 0;
+            for (int i = 0; i < GPS_COUNT; i++)
+            {
+                if (sources & (1 << i))
+                    version = std::max(version, mVersions[i]);
+            }
+            return version;
+        }
         /** Updates the current renderable */
         void setCurrentRenderable(const Renderable* rend);
         /** Sets the world matrices, avoid query from renderable again */
@@ -592,6 +592,11 @@ namespace Ogre {
         bool isVisible(const Sphere& bound, FrustumPlane* culledBy = 0) const override;
         /// @copydoc Frustum::isVisible(const Vector3&, FrustumPlane*) const
         bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const override;
+        /// @copydoc Frustum::isVisible(const Vector3*, const Vector3*, size_t, uint32*) const
+        void isVisible(const Vector3* centres, const Vector3* halfSizes, size_t count,
+                       uint32* visibility) const override;
+        /// @copydoc Frustum::isVisible(const Sphere*, size_t, uint32*) const
+        void isVisible(const Sphere* spheres, size_t count, uint32* visibility) const override;
         /// @copydoc Frustum::getWorldSpaceCorners
         const Corners& getWorldSpaceCorners(void) const override;
         /// @copydoc Frustum::getFrustumPlane
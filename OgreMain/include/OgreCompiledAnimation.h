@@ -0,0 +1,127 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#ifndef __CompiledAnimation_H__
+#define __CompiledAnimation_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreAnimation.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+/** \addtogroup Core
+ *  @{
+ */
+/** \addtogroup Animation
+ *  @{
+ */
+/** The node tracks of an Animation, resampled for fast evaluation
+
+    The tracks are sampled at a uniform rate, so the samples around a time position are found
+    by a division instead of searching the keyframes. The samples of all tracks are stored in
+    one contiguous array: for each sample time, the rotation x, y, z, w, the translation x, y, z
+    and the scale x, y, z components of all tracks follow each other. Interpolating a whole
+    pose is therefore a single loop over consecutive floats, which the compiler vectorises.
+
+    Optionally the samples are quantised to 16 bit within the range of each component and
+    track, which halves the memory needed.
+
+    Rotations are interpolated linearly and renormalised between the samples, so the sample
+    rate should be high enough for the curvature of the animation. Track listeners
+    (NodeAnimationTrack::setListener) are only considered while sampling.
+
+    Use Animation::compile to have Animation::apply use this for skeletons.
+*/
+class _OgreExport CompiledAnimation : public AnimationAlloc
+{
+public:
+    /// the components of a track in a Pose
+    enum Component
+    {
+        ROTATION_X,
+        ROTATION_Y,
+        ROTATION_Z,
+        ROTATION_W,
+        TRANSLATE_X,
+        TRANSLATE_Y,
+        TRANSLATE_Z,
+        SCALE_X,
+        SCALE_Y,
+        SCALE_Z,
+        NUM_COMPONENTS
+    };
+
+    /// The interpolated transforms of all tracks at a time
+    struct Pose
+    {
+        /// component c of track t is at c * numTracks + t
+        std::vector<float> data;
+        size_t numTracks;
+
+        const float* getComponent(Component c) const { return data.data() + c * numTracks; }
+        Quaternion getRotation(size_t track) const;
+        Vector3 getTranslate(size_t track) const;
+        Vector3 getScale(size_t track) const;
+    };
+
+    /** Resamples the node tracks of the given animation
+    @param anim
+        the animation. Its keyframes are not referenced afterwards.
+    @param sampleRate
+        samples per second. The first and last samples are at the start and the end of the
+        animation, so the actual rate is slightly higher.
+    @param quantise
+        whether to store the samples as 16 bit integers
+    */
+    CompiledAnimation(const Animation* anim, Real sampleRate = 30, bool quantise = false);
+
+    /** Interpolates the transforms of all tracks at the given time
+
+        The time is wrapped like in Animation::_getTimeIndex.
+    */
+    void samplePose(Real timePos, Pose& pose) const;
+
+    /** Same as Animation::apply for the node tracks the animation had when it was compiled
+    @param skeleton
+    @param timePos
+    @param weight
+    @param blendMask optional per bone weights
+    @param scale
+    */
+    void apply(Skeleton* skeleton, Real timePos, float weight, const AnimationState::BoneBlendMask* blendMask,
+               Real scale) const;
+
+    /// the handles of the tracks, in the order of a Pose
+    const std::vector<ushort>& getTrackHandles() const { return mHandles; }
+    /// number of samples per track
+    size_t getNumSamples() const { return mNumSamples; }
+    bool isQuantised() const { return !mQuantisedSamples.empty(); }
+    /// the memory used by the samples, in bytes
+    size_t getSampleMemoryUsage() const;
+
+private:
+    template <typename T> void interpolate(const T* a, const T* b, float t, float* out) const;
+
+    Real mLength;
+    /// time between two samples
+    Real mInterval;
+    size_t mNumSamples;
+    Animation::RotationInterpolationMode mRotationInterpolationMode;
+    std::vector<ushort> mHandles;
+    std::vector<uint8> mUseShortestRotationPath;
+    /// per sample NUM_COMPONENTS * number of tracks values
+    std::vector<float> mSamples;
+    std::vector<uint16> mQuantisedSamples;
+    /// the value of the quantised 0 and the step per quantised unit, per component and track
+    std::vector<float> mQuantisationOffset, mQuantisationScale;
+};
+/** @} */
+/** @} */
+} // namespace Ogre
+
+#include "OgreHeaderSuffix.h"
+
+#endif
@@ -360,6 +360,41 @@ namespace Ogre {
         void setFreeOnClose(bool free) { mFreeOnClose = free; }
     };
 
+    /** Read-only MemoryDataStream of a memory mapped file.
+
+        The contents are paged in on access, so consumers which work on a
+        MemoryDataStream read directly from the page cache instead of a copy
+        of the file. The mapping is released when the stream is closed.
+        On platforms without mmap the file is read into memory instead.
+    */
+    class _OgreExport MmapDataStream : public MemoryDataStream
+    {
+    private:
+        struct Mapping
+        {
+            void* data;
+            size_t size;
+        };
+        static Mapping mapFile(const String& path);
+
+        MmapDataStream(const String& name, const Mapping& mapping);
+
+        /// Whether the mapping was not released yet
+        bool mMapped;
+    public:
+        /** Map the file at the given path.
+        @param path The path of the file to map
+        @param name The name to give the stream, the path if empty
+        */
+        explicit MmapDataStream(const String& path, const String& name = "");
+
+        ~MmapDataStream();
+
+        /** @copydoc DataStream::close
+        */
+        void close(void) override;
+    };
+
     /** Common subclass of DataStream for handling data from 
         std::basic_istream.
     */
@@ -225,6 +225,10 @@ namespace Ogre {
         /// Perform all the updates required for an animated entity.
         void updateAnimation(void);
 
+        /// Mesh::softwareVertexBlend, or queued to the SceneManager if it collects them
+        void softwareVertexBlend(const VertexData* sourceVertexData, const VertexData* targetVertexData,
+                                 const Affine3* const* blendMatrices, size_t numMatrices, bool blendNormals);
+
         /// Records the last frame in which the bones was updated.
         /// It's a pointer because it can be shared between different entities with
         /// a shared skeleton.
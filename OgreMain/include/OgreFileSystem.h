@@ -68,6 +68,14 @@ namespace Ogre {
 
         /// Get whether hidden files are ignored during filesystem enumeration.
         static bool getIgnoreHidden();
+
+        /// Set whether files opened read-only are memory mapped, see MmapDataStream.
+        /// Consumers then read directly from the page cache instead of copying the file
+        /// into memory first. The default is false.
+        static void setUseMemoryMapping(bool useMapping);
+
+        /// Get whether files opened read-only are memory mapped.
+        static bool getUseMemoryMapping();
     };
 
     class APKFileSystemArchiveFactory : public ArchiveFactory
@@ -0,0 +1,109 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#ifndef __FrameTaskGraph_H__
+#define __FrameTaskGraph_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreHeaderPrefix.h"
+
+namespace Ogre
+{
+/** \addtogroup Core
+ *  @{
+ */
+/** \addtogroup General
+ *  @{
+ */
+/** Jobs run every frame, ordered by their dependencies
+
+    Jobs which do not depend on each other run concurrently on the WorkQueue, so independent
+    systems, e.g. the animation of different characters or the game logic, can use all cores.
+    The thread calling run() takes part in processing the jobs, so the graph completes even if
+    the WorkQueue is paused or was not started.
+
+    Root runs its graph in Root::renderOneFrame, after FrameListener::frameStarted and before
+    the render targets are updated. The engine registers the following jobs there:
+    - "Controllers": updates all controllers of the ControllerManager
+    - "SceneAnimations": applies the enabled scene animations of all SceneManagers, after "Controllers"
+
+    Jobs only see the effects of the jobs they (transitively) depend on, so a job which moves
+    nodes that are animated should depend on "SceneAnimations".
+
+    The duration of every job is measured, so the frame can be profiled per job.
+*/
+class _OgreExport FrameTaskGraph : public UtilityAlloc
+{
+public:
+    typedef uint32 JobId;
+
+    FrameTaskGraph();
+    ~FrameTaskGraph();
+
+    /** Add a job to be run every frame
+
+        As the dependencies must be added first, the graph can not contain cycles.
+        @param name name of the job for profiling and findJob
+        @param func the work to do
+        @param dependencies the jobs that must be completed before this one starts
+        @param mainThread run on the thread calling run(), e.g. if the job uses the RenderSystem
+        @return the id of the job
+    */
+    JobId addJob(const String& name, std::function<void()> func, const std::vector<JobId>& dependencies = {},
+                 bool mainThread = false);
+
+    /** Remove a job
+
+        No other job may depend on it. The ids of the other jobs stay valid.
+    */
+    void removeJob(JobId id);
+
+    /// Get the id of the job with the given name
+    JobId findJob(const String& name) const;
+
+    /// Get the number of jobs in the graph
+    size_t getNumJobs() const { return mNumJobs; }
+
+    /** Run all jobs and wait until they are completed
+
+        Must not be called from a job and jobs must not be added or removed meanwhile.
+        If a job throws, the exception is rethrown here after the other jobs completed.
+        @param queue the queue to run the jobs on or NULL to run them all on the calling thread
+    */
+    void run(WorkQueue* queue);
+
+    /// Get the time the job took in the last run in microseconds
+    uint64 getJobDuration(JobId id) const;
+
+    /// Get the time the last run took in microseconds
+    uint64 getLastRunDuration() const { return mLastRunDuration; }
+
+private:
+    struct Job
+    {
+        String name;
+        std::function<void()> func;
+        /// the jobs waiting for this one
+        std::vector<JobId> dependents;
+        uint32 numDependencies;
+        bool mainThread;
+        bool removed;
+        uint64 duration;
+    };
+    struct RunState;
+
+    const Job& getJob(JobId id) const;
+
+    std::vector<Job> mJobs;
+    size_t mNumJobs;
+    uint64 mLastRunDuration;
+};
+/** @} */
+/** @} */
+} // namespace Ogre
+
+#include "OgreHeaderSuffix.h"
+
+#endif
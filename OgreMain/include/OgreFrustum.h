@@ -420,6 +420,41 @@ namespace Ogre
         */
         virtual bool isVisible(const Vector3& vert, FrustumPlane* culledBy = 0) const;
 
+        /** Tests whether the given boxes are visible in the Frustum.
+
+            Gives the same results as isVisible(const AxisAlignedBox&, FrustumPlane*) for each box,
+            but tests four boxes at a time using SSE or NEON, if available. Use this to cull
+            large numbers of objects, e.g. static props.
+        @param centres
+            Centres of the bounding boxes (world space).
+        @param halfSizes
+            Half sizes of the bounding boxes. Null and infinite boxes cannot be represented
+            this way, so they must be handled by the caller.
+        @param count
+            Number of boxes to test.
+        @param visibility
+            Receives one bit per box, which is set if the box is visible. The result for box
+            @c i is stored in bit <tt>i % 32</tt> of <tt>visibility[i / 32]</tt>, so the array
+            must hold at least <tt>(count + 31) / 32</tt> elements.
+        @note Subclasses overriding isVisible(const AxisAlignedBox&, FrustumPlane*) should
+            override this as well, as it is used by the SceneManager to cull scene nodes.
+        */
+        virtual void isVisible(const Vector3* centres, const Vector3* halfSizes, size_t count,
+                               uint32* visibility) const;
+
+        /** Tests whether the given spheres are visible in the Frustum.
+
+            Gives the same results as isVisible(const Sphere&, FrustumPlane*) for each sphere,
+            but tests four spheres at a time using SSE or NEON, if available.
+        @param spheres
+            Bounding spheres to be checked (world space).
+        @param count
+            Number of spheres to test.
+        @param visibility
+            Receives one bit per sphere, see above.
+        */
+        virtual void isVisible(const Sphere* spheres, size_t count, uint32* visibility) const;
+
         uint32 getTypeFlags(void) const override;
         const AxisAlignedBox& getBoundingBox(void) const override;
         Real getBoundingRadius(void) const override;
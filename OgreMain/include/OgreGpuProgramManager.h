@@ -91,9 +91,16 @@ namespace Ogre {
     protected:
 
         SharedParametersMap mSharedParametersMap;
-        std::map<uint32, Microcode> mMicrocodeCache;
+        /// also holds the microcodes read from mMicrocodeCacheDirectory on demand
+        mutable std::map<uint32, Microcode> mMicrocodeCache;
         bool mSaveMicrocodesToCache;
         bool mCacheDirty;           // When this is true the cache is 'dirty' and should be resaved to disk.
+        String mMicrocodeCacheDirectory;
+        OGRE_WQ_MUTEX(mMicrocodeCacheMutex);
+
+        String getMicrocodeCachePath(uint32 id) const;
+        /// find the microcode in the cache or its directory, must be locked
+        const Microcode* findMicrocode(uint32 id) const;
             
         static String addRenderSystemToName( const String &  name );
 
@@ -276,6 +283,20 @@ namespace Ogre {
         */
         void removeMicrocodeFromCache(uint32 id);
 
+        /** Set a directory that stores the microcode of every program in its own file
+
+            Microcodes added to the cache are written to the directory immediately. Microcodes
+            missing in the cache are looked up there and memory mapped when they are needed.
+            So several runs and processes can share the directory, and each only compiles the
+            programs that are not in it yet. The files are keyed by a 128 bit hash of the
+            program id and the render system name, and their contents are verified when read.
+            Requires setSaveMicrocodesToCache.
+        @param path The directory, which is created if needed. Empty to disable.
+        */
+        void setMicrocodeCacheDirectory(const String& path);
+        /// Get the directory set by setMicrocodeCacheDirectory
+        const String& getMicrocodeCacheDirectory() const { return mMicrocodeCacheDirectory; }
+
         /** Saves the microcode cache to disk.
         @param stream The destination stream
         */
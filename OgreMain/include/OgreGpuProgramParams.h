@@ -137,6 +137,32 @@ namespace Ogre {
         GPV_ALL = 0xFFFF
     };
 
+    /** The data an automatic GPU parameter is derived from.
+
+        AutoParamDataSource keeps a version for each of these, so parameters are only
+        derived again if their data changed.
+        These values must be powers of two since they are used in masks.
+    */
+    enum GpuParamSource : uint8
+    {
+        /// The current renderable and its world matrices
+        GPS_OBJECT = 1,
+        /// The camera, viewport and render target
+        GPS_CAMERA = 2,
+        /// The current lights and shadow projectors
+        GPS_LIGHTS = 4,
+        /// The current pass
+        GPS_PASS = 8,
+        /// Ambient light, fog and point parameters
+        GPS_SCENE = 16,
+        /// The frame time
+        GPS_TIME = 32,
+
+        GPS_COUNT = 6,
+        /// Full mask
+        GPS_ALL = 0x3F
+    };
+
     /** Information about predefined program constants.
         @note Only available for high-level programs but is referenced generically
         by GpuProgramParameters.
@@ -1203,16 +1229,22 @@ namespace Ogre {
                 Used in case people used packed elements smaller than 4 (e.g. GLSL)
                 and bind an auto which is 4-element packed to it */
             uint8 elementCount;
+            /// The data this parameter is derived from (see GpuParamSource), 0 to always update it
+            uint8 sources;
+            /// The AutoParamDataSource version the current value was derived from
+            uint64 version;
 
         AutoConstantEntry(AutoConstantType theType, size_t theIndex, uint32 theData,
                           uint16 theVariability, uint8 theElemCount = 4)
             : physicalIndex(theIndex), paramType(theType),
-                data(theData), variability(theVariability), elementCount(theElemCount) {}
+                data(theData), variability(theVariability), elementCount(theElemCount),
+                sources(deriveSources(theType)), version(0) {}
 
         AutoConstantEntry(AutoConstantType theType, size_t theIndex, float theData,
                           uint16 theVariability, uint8 theElemCount = 4)
             : physicalIndex(theIndex), paramType(theType),
-                fData(theData), variability(theVariability), elementCount(theElemCount) {}
+                fData(theData), variability(theVariability), elementCount(theElemCount),
+                sources(deriveSources(theType)), version(0) {}
 
         };
         // Auto parameter storage
@@ -1252,6 +1284,8 @@ namespace Ogre {
 
         /// Return the variability for an auto constant
         static uint16 deriveVariability(AutoConstantType act);
+        /// Return the GpuParamSource mask for an auto constant
+        static uint8 deriveSources(AutoConstantType act);
 
         void copySharedParamSetUsage(const GpuSharedParamUsageList& srcList);
 
@@ -1630,6 +1664,9 @@ namespace Ogre {
         /// @}
 
         /** Update automatic parameters.
+
+            Parameters whose GpuParamSource did not change since they were last updated
+            from the same source are skipped.
             @param source The source of the parameters
             @param variabilityMask A mask of GpuParamVariability which identifies which autos will need updating
         */
@@ -112,7 +112,7 @@ namespace Ogre {
 
         class Stream;
 
-        OGRE_AUTO_MUTEX; // public to allow external locking
+        OGRE_WQ_MUTEX(OGRE_AUTO_MUTEX_NAME); // public to allow external locking
         /**
 
             Usual constructor - called by LogManager.
@@ -39,6 +39,7 @@ THE SOFTWARE.
 #include "OgreSharedPtr.h"
 #include "OgreUserObjectBindings.h"
 #include "OgreVertexIndexData.h"
+#include <functional>
 
 
 namespace Ogre {
@@ -780,6 +781,53 @@ namespace Ogre {
             const Affine3* const* blendMatrices, size_t numMatrices,
             bool blendNormals);
 
+        /** The locked source and target data of a software vertex blend
+
+            Created by prepareSoftwareVertexBlend. The pointers are valid as long as the buffers
+            stay locked.
+        */
+        struct _OgreExport SoftwareVertexBlendInfo
+        {
+            const float* srcPos;
+            float* destPos;
+            /// NULL if normals are not blended
+            const float* srcNorm;
+            float* destNorm;
+            const float* blendWeight;
+            const unsigned char* blendIndex;
+            size_t srcPosStride, destPosStride;
+            size_t srcNormStride, destNormStride;
+            size_t blendWeightStride, blendIndexStride;
+            size_t numWeightsPerVertex;
+            size_t numVertices;
+
+            /** Blends the vertices [start, start + count)
+
+                Different ranges can be blended concurrently.
+            */
+            void blend(const Affine3* const* blendMatrices, size_t start, size_t count) const;
+        };
+
+        /// Locks the buffer with the given options, returning the data pointer
+        typedef std::function<void*(HardwareBuffer*, HardwareBuffer::LockOptions)> LockBufferFunction;
+
+        /** Locks the buffers of softwareVertexBlend, without blending yet
+
+            This allows to defer the blend, or to split it into several ranges.
+        @param sourceVertexData
+            as in softwareVertexBlend
+        @param targetVertexData
+            as in softwareVertexBlend
+        @param blendNormals
+            as in softwareVertexBlend
+        @param lockBuffer
+            called for each of the buffers that need to be locked. Source and target might
+            use the same buffer for several elements, so it must return the data of buffers
+            it already locked again.
+        */
+        static SoftwareVertexBlendInfo prepareSoftwareVertexBlend(const VertexData* sourceVertexData,
+            const VertexData* targetVertexData, bool blendNormals, const LockBufferFunction& lockBuffer);
+
         /** Performs a software vertex morph, of the kind used for
             morph animation although it can be used for other purposes. 
 
@@ -56,6 +56,7 @@ namespace Ogre {
     */
     class _OgreExport Node : public NodeAlloc
     {
+        friend class NodeTransformStore;
     public:
         /** Enumeration denoting the spaces which a transform can be relative to.
         */
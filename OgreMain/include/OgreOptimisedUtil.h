@@ -72,6 +72,12 @@ namespace Ogre {
         */
         static OptimisedUtil* getImplementation(void) { return msImplementation; }
 
+        /** Gets the implementation for the given instruction set, e.g. to compare them.
+        @param isa "General", "SSE" (which uses NEON on ARM) or "AVX2"
+        @return NULL if the implementation is not compiled in or the CPU does not support it
+        */
+        static OptimisedUtil* _getImplementation(const String& isa);
+
         /** Performs software vertex skinning.
         @param srcPosPtr Pointer to source position buffer.
         @param destPosPtr Pointer to destination position buffer.
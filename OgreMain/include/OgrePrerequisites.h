@@ -88,9 +88,11 @@ namespace Ogre {
     class BillboardChain;
     class BillboardSet;
     class Bone;
+    class BoundingVolumeHierarchy;
     class Camera;
     class Codec;
     class ColourValue;
+    class CompiledAnimation;
     class ConfigDialog;
     template <typename T> class Controller;
     typedef Controller<float> ControllerFloat;
@@ -112,6 +114,7 @@ namespace Ogre {
     class Factory;
     struct FrameEvent;
     class FrameListener;
+    class FrameTaskGraph;
     class Frustum;
     struct GpuLogicalBufferStruct;
     struct GpuNamedConstants;
@@ -163,6 +166,7 @@ namespace Ogre {
     class Node;
     class NodeAnimationTrack;
     class NodeKeyFrame;
+    class NodeTransformStore;
     class NumericAnimationTrack;
     class NumericKeyFrame;
     class Particle;
@@ -175,6 +179,7 @@ namespace Ogre {
     class ParticleSystemRenderer;
     template<typename T> class FactoryObj;
     typedef FactoryObj<ParticleSystemRenderer> ParticleSystemRendererFactory;
+    class ParallelSceneCuller;
     class Pass;
     class PatchMesh;
     class PixelBox;
@@ -228,8 +233,10 @@ namespace Ogre {
     class Skeleton;
     class SkeletonInstance;
     class SkeletonManager;
+    class SoftwareSkinningBatch;
     class Sphere;
     class SphereSceneQuery;
+    class StaticDrawList;
     class StaticGeometry;
     class StreamSerialiser;
     class StringConverter;
@@ -140,6 +140,7 @@ namespace Ogre {
         bool mSplitPassesByLightingType;
         bool mSplitNoShadowPasses;
         bool mShadowCastersCannotBeReceivers;
+        bool mSortKeysEnabled;
 
         RenderableListener* mRenderableListener;
     public:
@@ -275,6 +276,19 @@ namespace Ogre {
         */
         bool getShadowCastersCannotBeReceivers(void) const;
 
+        /** Sets whether the queue groups order the renderables by sort keys instead of pass maps
+
+            The queue groups and priorities are still kept apart, but within a priority group the
+            renderables are put into flat lists which are radix sorted by pass hash and depth.
+            This visits them in the same order and avoids the allocations of the pass maps.
+            Must be called while the queue is empty.
+        @see QueuedRenderableCollection::setSortKeysEnabled
+        */
+        void setSortKeysEnabled(bool enabled);
+
+        /** Gets whether the queue groups order the renderables by sort keys */
+        bool getSortKeysEnabled(void) const { return mSortKeysEnabled; }
+
         /** Set a renderable listener on the queue.
 
             There can only be a single renderable listener on the queue, since
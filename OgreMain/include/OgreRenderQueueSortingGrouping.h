@@ -150,11 +150,17 @@ namespace Ogre {
 
         /// Bitmask of the organisation modes requested
         uint8 mOrganisationMode;
+        /// Whether the items are ordered by sorting keys instead of the pass map
+        bool mSortKeysEnabled;
 
         /// Grouped 
         PassGroupRenderableMap mGrouped;
-        /// Sorted descending (can iterate backwards to get ascending)
+        /// Sorted descending (can iterate backwards to get ascending), ascending with sort keys
         RenderablePassList mSortedDescending;
+        /// Grouped by sorting the items by pass, used instead of mGrouped with sort keys
+        RenderablePassList mGroupedFlat;
+        /// Renderables of the pass currently visited in mGroupedFlat
+        mutable RenderableList mVisitedGroup;
 
         /// Internal visitor implementation
         void acceptVisitorGrouped(QueuedRenderableVisitor* visitor) const;
@@ -196,6 +202,19 @@ namespace Ogre {
             mOrganisationMode |= uint8(om);
         }
 
+        /** Sets whether the items are ordered by sorting flat lists by a key instead of grouping them in a map
+
+            With sort keys the passes are grouped by radix sorting the items by pass hash and the items are
+            sorted by a 64 bit key made of the depth and the pass hash. This visits the items in the same
+            order, but needs no allocations per frame once the lists have grown. Equal distances are always
+            ordered like the default does for more than 2000 items.
+
+            You can only do this when the collection is empty.
+        */
+        void setSortKeysEnabled(bool enabled) { mSortKeysEnabled = enabled; }
+        /// Gets whether the items are ordered by sort keys
+        bool getSortKeysEnabled() const { return mSortKeysEnabled; }
+
         /// Add a renderable to the collection using a given pass
         void addRenderable(Pass* pass, Renderable* rend);
         
@@ -356,6 +375,14 @@ namespace Ogre {
             mShadowCastersNotReceivers = ind;
         }
 
+        /** Sets whether the collections of this group are ordered by sort keys
+
+            You can only do this when the group is empty, i.e. after clearing the 
+            queue.
+        @see QueuedRenderableCollection::setSortKeysEnabled
+        */
+        void setSortKeysEnabled(bool enabled);
+
         /** Merge group of renderables. 
         */
         void merge( const RenderPriorityGroup* rhs );
@@ -387,6 +414,12 @@ namespace Ogre {
         bool mShadowsEnabled;
         /// Bitmask of the organisation modes requested (for new priority groups)
         uint8 mOrganisationMode;
+        /// Whether the priority groups are ordered by sort keys
+        bool mSortKeysEnabled;
+        /// Whether the renderables of this group are static
+        bool mStatic;
+        /// Incremented whenever the renderables of a static group changed
+        uint32 mStaticVersion;
 
 
     public:
@@ -398,6 +431,9 @@ namespace Ogre {
             , mShadowCastersNotReceivers(shadowCastersNotReceivers)
             , mShadowsEnabled(true)
             , mOrganisationMode(0)
+            , mSortKeysEnabled(false)
+            , mStatic(false)
+            , mStaticVersion(0)
         {
         }
 
@@ -430,6 +466,7 @@ namespace Ogre {
                     pPriorityGrp->resetOrganisationModes();
                     pPriorityGrp->addOrganisationMode((QueuedRenderableCollection::OrganisationMode)mOrganisationMode);
                 }
+                pPriorityGrp->setSortKeysEnabled(mSortKeysEnabled);
 
                 mPriorityGroups.emplace(priority, pPriorityGrp);
             }
@@ -578,6 +615,43 @@ namespace Ogre {
             }
         }
 
+        /** Sets whether the priority groups are ordered by sort keys
+
+            You can only do this when the group is empty, ie after clearing the 
+            queue.
+        @see QueuedRenderableCollection::setSortKeysEnabled
+        */
+        void setSortKeysEnabled(bool enabled)
+        {
+            mSortKeysEnabled = enabled;
+            for (auto& pg : mPriorityGroups)
+                pg.second->setSortKeysEnabled(enabled);
+        }
+        /// Gets whether the priority groups are ordered by sort keys
+        bool getSortKeysEnabled() const { return mSortKeysEnabled; }
+
+        /** Sets whether the renderables of this group are static
+
+            The SceneManager records the draws it issues for a static group, including the passes
+            and lights it derived for each renderable, and replays them as long as the same
+            renderables are queued and neither the camera nor the lights changed. This saves most
+            of the per draw work for large static worlds.
+        @par
+            Changes the queue can not detect, like moving a renderable of the group or changing
+            its geometry, must be announced by calling invalidateStatic.
+        */
+        void setStatic(bool enabled)
+        {
+            mStatic = enabled;
+            mStaticVersion++;
+        }
+        /// Gets whether the renderables of this group are static
+        bool isStatic() const { return mStatic; }
+        /// Discard the draws recorded for this group, e.g. after moving one of its renderables
+        void invalidateStatic() { mStaticVersion++; }
+        /// Internal method, incremented whenever the recorded draws are invalidated
+        uint32 _getStaticVersion() const { return mStaticVersion; }
+
         /** Merge group of renderables. 
         */
         void merge( const RenderQueueGroup* rhs )
@@ -602,6 +676,7 @@ namespace Ogre {
                         pDstPriorityGrp->resetOrganisationModes();
                         pDstPriorityGrp->addOrganisationMode((QueuedRenderableCollection::OrganisationMode)mOrganisationMode);
                     }
+                    pDstPriorityGrp->setSortKeysEnabled(mSortKeysEnabled);
 
                     mPriorityGroups.emplace(priority, pDstPriorityGrp);
                 }
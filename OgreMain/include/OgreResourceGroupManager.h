@@ -280,6 +280,8 @@ namespace Ogre {
 
         ResourceLoadingListener *mLoadingListener;
 
+        bool mParallelLoading;
+
         /// Resource index entry, resourcename->location 
         typedef std::map<String, Archive*> ResourceLocationIndex;
 
@@ -346,6 +348,11 @@ namespace Ogre {
             Called as part of initialiseResourceGroup
         */
         void createDeclaredResources(ResourceGroup* grp);
+        /** Prepare the resources of the group, which load() would prepare, on the WorkQueue.
+
+            Called as part of loadResourceGroup with parallel loading
+        */
+        void prepareResourcesParallel(ResourceGroup* grp);
         /** Adds a created resource to a group. */
         void addCreatedResource(ResourcePtr& res, ResourceGroup& group) const;
         /** Get resource group */
@@ -942,6 +949,21 @@ namespace Ogre {
         /// Returns the current loading listener
         ResourceLoadingListener *getLoadingListener() const;
 
+        /** Set whether resource groups are initialised and loaded using the WorkQueue
+
+            The scripts are then read and tokenized and the resources are prepared, i.e. read and
+            decoded, concurrently by the worker threads. The scripts are still parsed and the
+            resources are still loaded, e.g. uploaded to the GPU, one after another on the calling
+            thread, in the same order and with the same events as without parallel loading.
+
+            Only enable this, if preparing the used resource types is thread safe, as with
+            ResourceBackgroundQueue::prepare. Scripts are read on the calling thread, if a
+            ResourceLoadingListener is set.
+        */
+        void setParallelLoading(bool enabled) { mParallelLoading = enabled; }
+        /// Get whether resource groups are initialised and loaded using the WorkQueue
+        bool getParallelLoading() const { return mParallelLoading; }
+
         /// @copydoc Singleton::getSingleton()
         static ResourceGroupManager& getSingleton(void);
         /// @copydoc Singleton::getSingleton()
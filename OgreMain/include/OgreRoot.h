@@ -95,6 +95,7 @@ namespace Ogre
         std::unique_ptr<DynLibManager> mDynLibManager;
         std::unique_ptr<Timer> mTimer;
         std::unique_ptr<WorkQueue> mWorkQueue;
+        std::unique_ptr<FrameTaskGraph> mFrameTaskGraph;
         std::unique_ptr<ResourceGroupManager> mResourceGroupManager;
         std::unique_ptr<ResourceBackgroundQueue> mResourceBackgroundQueue;
         std::unique_ptr<MaterialManager> mMaterialManager;
@@ -494,7 +495,8 @@ namespace Ogre
 
         /** Updates all the render targets automatically
 
-            Raises frame events before and after.
+            Raises frame events before and after. The jobs of the FrameTaskGraph are run
+            after FrameListener::frameStarted.
 
             Overview of the render cycle
             ![](renderOneFrame.svg)
@@ -881,6 +883,13 @@ namespace Ogre
         */
         WorkQueue* getWorkQueue() const { return mWorkQueue.get(); }
 
+        /** Get the jobs run every frame by renderOneFrame
+
+            Register the per frame work of your systems here, so independent systems run
+            concurrently on the WorkQueue.
+        */
+        FrameTaskGraph* getFrameTaskGraph() const { return mFrameTaskGraph.get(); }
+
         /** Replace the current work queue with an alternative.
             You can use this method to replace the internal implementation of
             WorkQueue with  your own, e.g. to externalise the processing of
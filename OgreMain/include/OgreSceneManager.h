@@ -121,6 +121,8 @@ namespace Ogre {
         */
         void mergeNonRenderedButInFrustum(const AxisAlignedBox& boxBounds, 
             const Sphere& sphereBounds, const Camera* cam);
+        /// Merge the bounds collected by another instance for the same camera
+        void merge(const VisibleObjectsBoundsInfo& rhs);
 
 
     };
@@ -548,6 +550,7 @@ namespace Ogre {
         uint8 mWorldGeometryRenderQueue;
         
         unsigned long mLastFrameNumber;
+        unsigned long mLastAnimationFrameNumber;
         bool mResetIdentityView;
         bool mResetIdentityProj;
 
@@ -982,6 +985,17 @@ namespace Ogre {
         /// Visibility mask used to show / hide objects
         uint32 mVisibilityMask;
         bool mFindVisibleObjects;
+        bool mParallelSceneGraphUpdate;
+        /// flat copy of the scene graph transforms, if enabled
+        std::unique_ptr<NodeTransformStore> mNodeTransformStore;
+        /// distributes _findVisibleObjects over the WorkQueue, if enabled
+        std::unique_ptr<ParallelSceneCuller> mParallelSceneCuller;
+        /// collects the software skinning of _findVisibleObjects for the WorkQueue, if enabled
+        std::unique_ptr<SoftwareSkinningBatch> mSoftwareSkinningBatch;
+        /// the draws recorded for static queue groups
+        std::map<const RenderQueueGroup*, std::unique_ptr<StaticDrawList>> mStaticDrawLists;
+        /// the draw list recording the draws currently issued, if any
+        StaticDrawList* mStaticDrawRecording;
 
         /// The active renderable visitor class - subclasses could override this
         SceneMgrQueuedRenderableVisitor* mActiveQueuedRenderableVisitor;
@@ -999,6 +1013,13 @@ namespace Ogre {
         /** Render a group in the ordinary way */
         void renderBasicQueueGroupObjects(RenderQueueGroup* pGroup,
             QueuedRenderableCollection::OrganisationMode om);
+        /** Find the recorded draws of a static group
+
+            @return NULL if the draws of the group can not be recorded in the current state
+        */
+        StaticDrawList* getStaticDrawList(const RenderQueueGroup* pGroup);
+        /// Issue the draws recorded for a static group
+        void renderStaticDraws(const StaticDrawList& drawList);
 
         void useLights(const LightList* lights, ushort limit);
         void bindGpuProgram(GpuProgram* prog);
@@ -2177,6 +2198,12 @@ namespace Ogre {
         */
         void _applySceneAnimations(void);
 
+        /** Internal method for applying the scene animations, unless that was already done in this frame.
+
+            Called by Root in its FrameTaskGraph and when rendering the scene.
+        */
+        void _updateSceneAnimations(void);
+
         /** Creates an animation which can be used to animate scene nodes.
 
             An animation is a collection of 'tracks' which over time change the position / orientation
@@ -3215,6 +3242,100 @@ namespace Ogre {
         */
         bool getFindVisibleObjects(void) { return mFindVisibleObjects; }
 
+        /** Sets whether the scene graph update should be distributed over the WorkQueue.
+
+            If enabled, independent subtrees of the scene graph are updated concurrently by
+            the worker threads of Root::getWorkQueue (see SceneNode::_updateParallel). The
+            derived transforms and world bounds are the same as with the serial update, but
+            Node::Listener and MovableObject::Listener callbacks will be invoked from the
+            worker threads. Default is false.
+        @note Scene managers which maintain shared spatial structures while nodes are being
+            updated (e.g. the Octree, PCZ and BSP scene managers) ignore this setting.
+        */
+        virtual void setParallelSceneGraphUpdate(bool enabled) { mParallelSceneGraphUpdate = enabled; }
+
+        /** Gets whether the scene graph update is distributed over the WorkQueue.
+        */
+        bool getParallelSceneGraphUpdate() const { return mParallelSceneGraphUpdate; }
+
+        /** Sets whether the scene graph is updated using a NodeTransformStore.
+
+            If enabled, the derived transforms of all nodes are additionally kept in
+            contiguous arrays ordered by hierarchy depth, so _updateSceneGraph processes them
+            in linear passes instead of recursing through the individually allocated nodes.
+            This pays off for large hierarchies with many moving nodes. The store is rebuilt
+            automatically when nodes are attached or detached. If the parallel scene graph
+            update is enabled too, the depth levels are processed on the WorkQueue.
+            Default is false.
+        @note Scene managers using SceneNode subclasses which customise the update
+            (e.g. the PCZ and BSP scene managers) ignore this setting.
+        */
+        virtual void setNodeTransformStoreEnabled(bool enabled);
+
+        /** Gets whether the scene graph is updated using a NodeTransformStore.
+        */
+        bool getNodeTransformStoreEnabled() const { return mNodeTransformStore != nullptr; }
+
+        /** Notifies the SceneManager that the hierarchy of its scene nodes has changed.
+        @note Called internally by SceneNode
+        */
+        void _notifySceneGraphLayoutChanged();
+
+        /** Sets whether visible objects are found using the worker threads of the WorkQueue.
+
+            If enabled, independent subtrees of the scene graph are culled concurrently, each
+            into a RenderQueue fragment of its own. The fragments are then merged into the
+            RenderQueueGroup and RenderPriorityGroup structures of the main queue before they
+            are sorted, in the same order the serial traversal would have produced.
+            This helps, if culling for several cameras (e.g. shadow cameras) takes a large share
+            of the frame time. Default is false.
+        @note MovableObject::_notifyCurrentCamera and MovableObject::_updateRenderQueue are
+            invoked from the worker threads, so the objects in the scene must support that.
+            E.g. entities sharing a skeleton do not. While a RenderQueue::RenderableListener is
+            set, the serial traversal is used.
+        @note Scene managers which implement their own _findVisibleObjects (e.g. the Octree,
+            PCZ and BSP scene managers) ignore this setting.
+        */
+        virtual void setParallelFindVisibleObjects(bool enabled);
+
+        /** Gets whether visible objects are found using the worker threads of the WorkQueue.
+        */
+        bool getParallelFindVisibleObjects() const { return mParallelSceneCuller != nullptr; }
+
+        /** Sets whether software skinning is deferred and distributed over the WorkQueue.
+
+            If enabled, entities which need software skinning (because hardware skinning is not
+            available, or for stencil shadows) don't blend their vertices while they are being
+            found visible. Instead the blends are collected, and after _findVisibleObjects the
+            vertices of all entities are blended concurrently by the worker threads of
+            Root::getWorkQueue. The results are the same, but the blended buffers stay locked until
+            then. Default is false.
+        */
+        void setParallelSoftwareSkinning(bool enabled);
+
+        /** Gets whether software skinning is deferred and distributed over the WorkQueue.
+        */
+        bool getParallelSoftwareSkinning() const { return mSoftwareSkinningBatch != nullptr; }
+
+        /** Starts collecting the software skinning of the entities, if parallel software skinning
+            is enabled.
+        @note Called internally by _renderScene around _findVisibleObjects
+        */
+        void _beginSoftwareSkinning();
+
+        /** Blends the vertices collected since _beginSoftwareSkinning on the WorkQueue.
+        @note Called internally by _renderScene around _findVisibleObjects
+        */
+        void _endSoftwareSkinning();
+
+        /** Queues a Mesh::softwareVertexBlend, if software skinning is being collected.
+        @note Called internally by Entity, possibly from several threads at once
+        @return false if the blend must be done immediately
+        */
+        bool _queueSoftwareVertexBlend(const VertexData* sourceVertexData, const VertexData* targetVertexData,
+                                       const Affine3* const* blendMatrices, size_t numMatrices,
+                                       bool blendNormals);
+
         /** Set whether to automatically flip the culling mode on objects whenever they
             are negatively scaled.
 
@@ -3258,7 +3379,8 @@ namespace Ogre {
         /** Method to allow you to mark gpu parameters as dirty, causing them to 
             be updated according to the mask that you set when updateGpuProgramParameters is
             next called. Only really useful if you're controlling parameter state in 
-            inner rendering loop callbacks.
+            inner rendering loop callbacks. All data of the AutoParamDataSource is
+            considered changed, so the parameters are not skipped as being up to date.
             @param mask Some combination of GpuParamVariability which is bitwise OR'ed with the
                 current dirty state.
         */
@@ -3344,7 +3466,13 @@ namespace Ogre {
         virtual void drawFrustum(const Frustum* frust) = 0;
     };
 
-    /** Default implementation of IntersectionSceneQuery. */
+    /** Default implementation of IntersectionSceneQuery.
+
+        Finds the candidate pairs using a BoundingVolumeHierarchy over the world bounds of the
+        objects. The hierarchy is kept between executions and only refitted to the moved objects,
+        unless objects were added or removed. The pairs are reported in the same order as a brute
+        force comparison of all objects would.
+    */
     class _OgreExport DefaultIntersectionSceneQuery : 
         public IntersectionSceneQuery
     {
@@ -3353,16 +3481,34 @@ namespace Ogre {
         ~DefaultIntersectionSceneQuery();
 
         void execute(IntersectionSceneQueryListener* listener) override;
+    private:
+        std::unique_ptr<BoundingVolumeHierarchy> mHierarchy;
+        std::vector<MovableObject*> mObjects;
+        std::vector<std::pair<uint32, uint32>> mPairs;
     };
 
-    /** Default implementation of RaySceneQuery. */
+    /** Default implementation of RaySceneQuery.
+
+        Uses a BoundingVolumeHierarchy over the world bounds of the objects, which is kept between
+        executions and refitted to the moved objects. If sorted results are limited, only the
+        nearest hits are searched for. Batches of rays are traversed in packets.
+    */
     class _OgreExport DefaultRaySceneQuery : public RaySceneQuery
     {
     public:
         DefaultRaySceneQuery(SceneManager* creator);
         ~DefaultRaySceneQuery();
 
+        using RaySceneQuery::execute;
         void execute(RaySceneQueryListener* listener) override;
+        void execute(const std::vector<Ray>& rays, std::vector<RaySceneQueryResult>& results) override;
+    private:
+        /// update the hierarchy to the objects currently passing the masks
+        void updateHierarchy();
+
+        std::unique_ptr<BoundingVolumeHierarchy> mHierarchy;
+        std::vector<MovableObject*> mObjects;
+        RaySceneQueryResult mHits;
     };
     /** Default implementation of SphereSceneQuery. */
     class _OgreExport DefaultSphereSceneQuery : public SphereSceneQuery
@@ -108,6 +108,10 @@ namespace Ogre {
             graph.
         */
         virtual void setInSceneGraph(bool inGraph);
+
+        /// _findVisibleObjects without the check of the own bounds
+        void findVisibleObjectsImpl(Camera* cam, RenderQueue* queue, VisibleObjectsBoundsInfo* visibleBounds,
+                                    bool includeChildren, bool displayNodes, bool onlyShadowCasters);
         /** See Node. */
         Node* createChildImpl(void) override;
 
@@ -194,6 +198,20 @@ namespace Ogre {
         */
         void _update(bool updateChildren, bool parentHasChanged) override;
 
+        /** Variant of _update(true, parentHasChanged) which updates independent subtrees in parallel.
+
+            The top of the hierarchy is walked on the calling thread until enough independent
+            subtrees are found to keep the workers busy. These are then updated concurrently
+            using WorkQueue::parallelFor and finally the world bounds of the upper nodes are
+            merged on the calling thread. The resulting derived transforms and world bounds are
+            identical to the ones computed by _update.
+            @note Node::Listener and MovableObject::Listener callbacks are invoked from the
+            worker threads.
+            @param queue The WorkQueue to distribute the subtrees on
+            @param parentHasChanged see _update
+        */
+        void _updateParallel(WorkQueue* queue, bool parentHasChanged = false);
+
         /** Tells the SceneNode to update the world bound info it stores.
         */
         virtual void _updateBounds(void);
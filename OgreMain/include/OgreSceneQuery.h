@@ -349,6 +349,16 @@ namespace Ogre {
         */
         virtual void execute(RaySceneQueryListener* listener) = 0;
 
+        /** Executes the query for several rays at once.
+
+            Gives the same results as calling setRay and execute() for every ray, but allows the
+            SceneManager to process the rays together, e.g. for picking or line of sight tests.
+            The ray set with setRay is not changed.
+        @param rays The rays to test
+        @param results Receives the results of every ray, sorted and limited as configured
+        */
+        virtual void execute(const std::vector<Ray>& rays, std::vector<RaySceneQueryResult>& results);
+
         /** Gets the results of the last query that was run using this object, provided
             the query was executed using the collection-returning version of execute. 
         */
@@ -443,6 +443,10 @@ namespace Ogre
         const StringVector& getScriptPatterns(void) const override;
         /// @copydoc ScriptLoader::parseScript
         void parseScript(DataStreamPtr& stream, const String& groupName) override;
+        /// @copydoc ScriptLoader::prepareScript
+        Any prepareScript(DataStreamPtr& stream) override;
+        /// @copydoc ScriptLoader::parsePreparedScript
+        void parsePreparedScript(const Any& prepared, const String& groupName) override;
         /// @copydoc ScriptLoader::getLoadingOrder
         Real getLoadingOrder(void) const override;
 
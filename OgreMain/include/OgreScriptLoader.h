@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include "OgrePrerequisites.h"
 #include "OgreDataStream.h"
 #include "OgreStringVector.h"
+#include "OgreAny.h"
 #include "OgreHeaderPrefix.h"
 
 namespace Ogre {
@@ -77,6 +78,22 @@ namespace Ogre {
         */
         virtual void parseScript(DataStreamPtr& stream, const String& groupName) = 0;
 
+        /** Do the part of parsing a script file which does not depend on other scripts.
+
+            With ResourceGroupManager::setParallelLoading, this is called concurrently for the
+            scripts of a group, which are then parsed one after another in loading order by
+            parsePreparedScript. It must therefore be thread safe and only return its results.
+        @param stream The script file
+        @return The prepared script or an empty Any, if the loader does not prepare scripts
+        */
+        virtual Any prepareScript(DataStreamPtr& stream) { return Any(); }
+
+        /** Parse a script file that was prepared by prepareScript.
+        @param prepared The value returned by prepareScript
+        @param groupName As in parseScript
+        */
+        virtual void parsePreparedScript(const Any& prepared, const String& groupName) {}
+
         /** Gets the loading order for scripts of this type.
 
             There are dependencies between some kinds of scripts, and this value enumerates that.
@@ -304,6 +304,11 @@ namespace Ogre {
         */
         virtual void optimiseAllAnimations(bool preservingIdentityNodeTracks = false);
 
+        /** Compile all of this skeleton's animations.
+        @see Animation::compile
+        */
+        virtual void compileAllAnimations(Real sampleRate = 30, bool quantise = false);
+
         /** Allows you to use the animations from another Skeleton object to animate
             this skeleton.
 
@@ -76,6 +76,18 @@ namespace Ogre
         /// Numeric identifier for a request
         typedef unsigned long long int RequestID;
 
+        /// Priority of a task, tasks with a higher priority are started first
+        enum TaskPriority
+        {
+            /// Background work, which may wait for everything else
+            TP_LOW,
+            /// The priority of tasks added without one
+            TP_NORMAL,
+            /// Work somebody is waiting for, like the chunks of parallelFor
+            TP_HIGH,
+            TP_COUNT
+        };
+
         /** General purpose request structure. 
         */
         class _OgreExport Request : public UtilityAlloc
@@ -159,6 +171,25 @@ namespace Ogre
 
         /** Add a new task to the queue */
         virtual void addTask(std::function<void()> task) = 0;
+
+        /** Add a new task to the queue with the given priority
+
+            The default implementation ignores the priority.
+        */
+        virtual void addTask(std::function<void()> task, TaskPriority priority) { addTask(std::move(task)); }
+
+        /** Call a function for every index in [begin, end), distributing the work over the worker threads
+
+            The calling thread takes part in processing the range and the call only returns after
+            all indices have been processed. Therefore this is safe to use even if the queue is
+            paused or all workers are busy - the calling thread will then simply do all the work.
+            @param begin first index of the range
+            @param end one past the last index of the range
+            @param func function to call for every index. Will be called concurrently and must not throw.
+            @param grainSize number of consecutive indices that are processed by one thread at a time
+        */
+        virtual void parallelFor(size_t begin, size_t end, const std::function<void(size_t)>& func,
+                                 size_t grainSize = 1);
         
         /** Set whether to pause further processing of any requests. 
         If true, any further requests will simply be queued and not processed until
@@ -217,6 +248,11 @@ namespace Ogre
     };
 
     /** Base for a general purpose task-based background work queue.
+
+        Every worker thread owns a task queue, where the tasks it adds itself go, while tasks
+        added by other threads are distributed over the queues. A worker takes the tasks from
+        its own queue first and steals from the queues of the other workers when it runs out
+        of work, so the workers rarely contend on the same lock.
     */
     class _OgreExport DefaultWorkQueueBase : public WorkQueue
     {
@@ -287,7 +323,8 @@ namespace Ogre
         size_t getWorkerThreadCount() const override { return mWorkerThreadCount; }
         void setWorkerThreadCount(size_t c) override { mWorkerThreadCount = c; }
         void addMainThreadTask(std::function<void()> task) override;
-        void addTask(std::function<void()> task) override;
+        void addTask(std::function<void()> task) override { addTask(std::move(task), TP_NORMAL); }
+        void addTask(std::function<void()> task, TaskPriority priority) override;
     protected:
         String mName;
         size_t mWorkerThreadCount;
@@ -295,7 +332,15 @@ namespace Ogre
         bool mIsRunning;
         unsigned long mResposeTimeLimitMS;
 
-        std::deque<std::function<void()>> mTasks;
+        struct TaskQueue;
+        /// one queue per worker thread
+        std::vector<std::unique_ptr<TaskQueue>> mTaskQueues;
+        /// number of tasks in mTaskQueues
+        std::atomic<size_t> mNumPendingTasks;
+        /// number of workers waiting for tasks
+        std::atomic<size_t> mNumWaitingWorkers;
+        /// the queue the next task added by a thread, which is not a worker, goes to
+        std::atomic<size_t> mNextTaskQueue;
         std::deque<std::function<void()>> mMainThreadTasks;
 
         bool mPaused;
@@ -307,6 +352,16 @@ namespace Ogre
 
         /// Notify workers about a new request. 
         virtual void notifyWorkers() = 0;
+
+        /** Set up one task queue per worker thread, keeping the queued tasks
+
+            Must not be called while workers are running.
+        */
+        void createTaskQueues(size_t count);
+        /// Make the task queue with the given index the one of the calling worker thread
+        void bindThreadToTaskQueue(size_t index);
+        /// Take the next task for the calling thread, by priority, from its own queue first
+        bool takeTask(std::function<void()>& task);
     };
 
 
@@ -63,6 +63,20 @@ namespace Ogre {
         using ArchiveFactory::createInstance;
 
         Archive *createInstance( const String& name, bool readOnly ) override;
+
+        /** Set whether archives are memory mapped and indexed lazily
+
+            Instead of reading the whole archive into memory and opening every entry on load,
+            the archive is memory mapped and only its central directory is read into a
+            hash index. Entries are decompressed when they are opened and stored entries
+            are returned as views of the mapping, without a copy.
+            Only stored and deflated entries are supported in this mode.
+            This should be called prior to declaring the resource locations. The default is false.
+        */
+        static void setUseMemoryMapping(bool useMapping);
+
+        /// Get whether archives are memory mapped and indexed lazily
+        static bool getUseMemoryMapping();
     };
 
     /** Specialisation of ZipArchiveFactory for embedded Zip files. */
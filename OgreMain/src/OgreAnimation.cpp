@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreAnimation.h"
 #include "OgreKeyFrame.h"
+#include "OgreCompiledAnimation.h"
 #include "OgreEntity.h"
 #include "OgreSubEntity.h"
 
@@ -63,6 +64,7 @@ namespace Ogre {
     void Animation::setLength(Real len)
     {
         mLength = len;
+        mCompiled.reset();
     }
     //---------------------------------------------------------------------
     NodeAnimationTrack* Animation::createNodeTrack(unsigned short handle)
@@ -330,6 +332,12 @@ namespace Ogre {
     {
         _applyBaseKeyFrame();
 
+        if (mCompiled)
+        {
+            mCompiled->apply(skel, timePos, weight, NULL, scale);
+            return;
+        }
+
         // Calculate time index for fast keyframe search
         TimeIndex timeIndex = _getTimeIndex(timePos);
 
@@ -348,6 +356,12 @@ namespace Ogre {
     {
         _applyBaseKeyFrame();
 
+        if (mCompiled)
+        {
+            mCompiled->apply(skel, timePos, weight, blendMask, scale);
+            return;
+        }
+
         // Calculate time index for fast keyframe search
         TimeIndex timeIndex = _getTimeIndex(timePos);
 
@@ -438,6 +452,7 @@ namespace Ogre {
     void Animation::setInterpolationMode(InterpolationMode im)
     {
         mInterpolationMode = im;
+        mCompiled.reset();
     }
     //---------------------------------------------------------------------
     Animation::InterpolationMode Animation::getInterpolationMode(void) const
@@ -474,6 +489,7 @@ namespace Ogre {
     void Animation::setRotationInterpolationMode(RotationInterpolationMode im)
     {
         mRotationInterpolationMode = im;
+        mCompiled.reset();
     }
     //---------------------------------------------------------------------
     Animation::RotationInterpolationMode Animation::getRotationInterpolationMode(void) const
@@ -593,6 +609,24 @@ namespace Ogre {
 
     }
     //-----------------------------------------------------------------------
+    void Animation::_keyFrameListChanged(void)
+    {
+        mKeyFrameTimesDirty = true;
+        mCompiled.reset();
+    }
+    //-----------------------------------------------------------------------
+    void Animation::compile(Real sampleRate, bool quantise)
+    {
+        // sample the rebased keyframes
+        _applyBaseKeyFrame();
+        mCompiled = std::make_unique<CompiledAnimation>(this, sampleRate, quantise);
+    }
+    //-----------------------------------------------------------------------
+    void Animation::discardCompiled()
+    {
+        mCompiled.reset();
+    }
+    //-----------------------------------------------------------------------
     TimeIndex Animation::_getTimeIndex(Real timePos) const
     {
         // Uncomment following statement for work as previous
@@ -34,6 +34,9 @@ THE SOFTWARE.
 #include "OgreViewport.h"
 
 namespace Ogre {
+    // spaces the versions of the instances apart, so parameters never match the version of another source
+    static std::atomic<uint32> msNextVersionBase(0);
+    static const int VERSION_BASE_SHIFT = 40;
     //-----------------------------------------------------------------------------
     AutoParamDataSource::AutoParamDataSource()
         : mWorldMatrixCount(0),
@@ -52,6 +55,8 @@ namespace Ogre {
          mCameraPositionDirty(true),
          mCameraPositionObjectSpaceDirty(true),
          mAmbientLight(ColourValue::Black),
+         mFogParams(0, 0, 0, 0),
+         mPointParams(0, 0, 0, 0),
          mPassNumber(0),
          mSceneDepthRangeDirty(true),
          mLodCameraPositionDirty(true),
@@ -65,8 +70,12 @@ namespace Ogre {
          mCurrentSceneManager(0),
          mMainCamBoundsInfo(0),
          mCurrentPass(0),
+         mUseIdentityView(false),
+         mUseIdentityProjection(false),
+         mLastVersion(uint64(msNextVersionBase++) << VERSION_BASE_SHIFT),
          mDummyNode(NULL)
     {
+        _markDirty(GPS_ALL);
         mBlankLight.setDiffuseColour(ColourValue::Black);
         mBlankLight.setSpecularColour(ColourValue::Black);
         mBlankLight.setAttenuation(0,1,0,0);
@@ -82,6 +91,16 @@ namespace Ogre {
         }
 
     }
+    //-----------------------------------------------------------------------------
+    void AutoParamDataSource::_markDirty(uint8 sources)
+    {
+        ++mLastVersion;
+        for (int i = 0; i < GPS_COUNT; i++)
+        {
+            if (sources & (1 << i))
+                mVersions[i] = mLastVersion;
+        }
+    }
     //-----------------------------------------------------------------------------
 	const Camera* AutoParamDataSource::getCurrentCamera() const
 	{
@@ -104,6 +123,17 @@ namespace Ogre {
     void AutoParamDataSource::setCurrentRenderable(const Renderable* rend)
     {
         mCurrentRenderable = rend;
+
+        // the renderable can override the view and projection
+        uint8 dirty = GPS_OBJECT;
+        bool useIdentityView = rend && rend->getUseIdentityView();
+        bool useIdentityProjection = rend && rend->getUseIdentityProjection();
+        if (useIdentityView != mUseIdentityView || useIdentityProjection != mUseIdentityProjection)
+            dirty |= GPS_CAMERA;
+        mUseIdentityView = useIdentityView;
+        mUseIdentityProjection = useIdentityProjection;
+        _markDirty(dirty);
+
         mWorldMatrixDirty = true;
         mViewMatrixDirty = true;
         mProjMatrixDirty = true;
@@ -130,6 +160,8 @@ namespace Ogre {
         mCurrentCamera = cam;
         mCameraRelativeRendering = useCameraRelative;
         mCameraRelativePosition = cam->getDerivedPosition();
+        // a new camera starts a new render, where any data queried on demand might have changed
+        _markDirty(GPS_ALL);
         mViewMatrixDirty = true;
         mProjMatrixDirty = true;
         mWorldViewMatrixDirty = true;
@@ -147,6 +179,7 @@ namespace Ogre {
     void AutoParamDataSource::setCurrentLightList(const LightList* ll)
     {
         mCurrentLightList = ll;
+        _markDirty(GPS_LIGHTS);
         for(size_t i = 0; i < ll->size() && i < OGRE_MAX_SIMULTANEOUS_LIGHTS; ++i)
         {
             mSpotlightViewProjMatrixDirty[i] = true;
@@ -259,11 +292,13 @@ namespace Ogre {
     {
         mMainCamBoundsInfo = info;
         mSceneDepthRangeDirty = true;
+        _markDirty(GPS_CAMERA);
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentSceneManager(const SceneManager* sm)
     {
         mCurrentSceneManager = sm;
+        _markDirty(GPS_ALL);
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setWorldMatrices(const Affine3* m, size_t count)
@@ -271,6 +306,7 @@ namespace Ogre {
         mWorldMatrixArray = m;
         mWorldMatrixCount = count;
         mWorldMatrixDirty = false;
+        _markDirty(GPS_OBJECT);
     }
     //-----------------------------------------------------------------------------
     const Affine3& AutoParamDataSource::getWorldMatrix(void) const
@@ -520,6 +556,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setAmbientLightColour(const ColourValue& ambient)
     {
+        if (ambient != mAmbientLight)
+            _markDirty(GPS_SCENE);
         mAmbientLight = ambient;
     }
     //---------------------------------------------------------------------
@@ -541,6 +579,8 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setCurrentPass(const Pass* pass)
     {
+        if (pass != mCurrentPass)
+            _markDirty(GPS_PASS);
         mCurrentPass = pass;
     }
     //-----------------------------------------------------------------------------
@@ -629,11 +669,13 @@ namespace Ogre {
         Real expDensity, Real linearStart, Real linearEnd)
     {
         (void)mode; // ignored
+        Vector4f params(expDensity, linearStart, linearEnd,
+                        linearEnd != linearStart ? 1 / (linearEnd - linearStart) : 0);
+        // set for every pass, but rarely changes
+        if (colour != mFogColour || params != mFogParams)
+            _markDirty(GPS_SCENE);
         mFogColour = colour;
-        mFogParams[0] = expDensity;
-        mFogParams[1] = linearStart;
-        mFogParams[2] = linearEnd;
-        mFogParams[3] = linearEnd != linearStart ? 1 / (linearEnd - linearStart) : 0;
+        mFogParams = params;
     }
     //-----------------------------------------------------------------------------
     const ColourValue& AutoParamDataSource::getFogColour(void) const
@@ -648,9 +690,12 @@ namespace Ogre {
 
     void AutoParamDataSource::setPointParameters(bool attenuation, const Vector4f& params)
     {
-        mPointParams = params;
+        Vector4f pointParams = params;
         if(attenuation)
-            mPointParams[0] *= getViewportHeight();
+            pointParams[0] *= getViewportHeight();
+        if (pointParams != mPointParams)
+            _markDirty(GPS_SCENE);
+        mPointParams = pointParams;
     }
 
     const Vector4f& AutoParamDataSource::getPointParams() const
@@ -662,6 +707,8 @@ namespace Ogre {
     {
         if (index < OGRE_MAX_SIMULTANEOUS_LIGHTS)
         {
+            if (frust != mCurrentTextureProjector[index])
+                _markDirty(GPS_LIGHTS);
             mCurrentTextureProjector[index] = frust;
             mTextureViewProjMatrixDirty[index] = true;
             mTextureWorldViewProjMatrixDirty[index] = true;
@@ -808,6 +855,7 @@ namespace Ogre {
     void AutoParamDataSource::setCurrentRenderTarget(const RenderTarget* target)
     {
         mCurrentRenderTarget = target;
+        _markDirty(GPS_CAMERA);
     }
     //-----------------------------------------------------------------------------
     const RenderTarget* AutoParamDataSource::getCurrentRenderTarget(void) const
@@ -818,16 +866,19 @@ namespace Ogre {
     void AutoParamDataSource::setCurrentViewport(const Viewport* viewport)
     {
         mCurrentViewport = viewport;
+        _markDirty(GPS_CAMERA);
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setShadowDirLightExtrusionDistance(Real dist)
     {
         mDirLightExtrusionDistance = dist;
+        _markDirty(GPS_LIGHTS);
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setShadowPointLightExtrusionDistance(Real dist)
     {
         mPointLightExtrusionDistance = dist;
+        _markDirty(GPS_LIGHTS);
     }
     //-----------------------------------------------------------------------------
     Real AutoParamDataSource::getShadowExtrusionDistance(void) const
@@ -1057,12 +1108,15 @@ namespace Ogre {
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::setPassNumber(const int passNumber)
     {
+        if (passNumber != mPassNumber)
+            _markDirty(GPS_PASS);
         mPassNumber = passNumber;
     }
     //-----------------------------------------------------------------------------
     void AutoParamDataSource::incPassNumber(void)
     {
         ++mPassNumber;
+        _markDirty(GPS_PASS);
     }
     int AutoParamDataSource::getMaterialLodIndex() const
     {
@@ -0,0 +1,375 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#include "OgreStableHeaders.h"
+#include "OgreBoundingVolumeHierarchy.h"
+
+namespace Ogre
+{
+namespace
+{
+const size_t PACKET_SIZE = 8;
+const size_t LEAF_SIZE = 4;
+const Real INF = std::numeric_limits<Real>::infinity();
+
+bool overlapsNode(const AxisAlignedBox& box, const Vector3& min, const Vector3& max)
+{
+    const Vector3& boxMin = box.getMinimum();
+    const Vector3& boxMax = box.getMaximum();
+    return !(boxMax.x < min.x || boxMax.y < min.y || boxMax.z < min.z || boxMin.x > max.x ||
+             boxMin.y > max.y || boxMin.z > max.z);
+}
+
+struct PacketRay
+{
+    Vector3 origin;
+    Vector3 direction;
+    Vector3 invDirection;
+};
+
+/// slab test against a node, which is conservative compared to Math::intersects
+bool intersectsNode(const PacketRay& ray, const Vector3& min, const Vector3& max, Real& entry)
+{
+    // nodes holding only objects with null bounds
+    if (min.x > max.x)
+        return false;
+
+    Real tmin = 0, tmax = INF;
+    for (int i = 0; i < 3; i++)
+    {
+        if (ray.direction[i] == 0)
+        {
+            if (ray.origin[i] < min[i] || ray.origin[i] > max[i])
+                return false;
+            continue;
+        }
+
+        Real t0 = (min[i] - ray.origin[i]) * ray.invDirection[i];
+        Real t1 = (max[i] - ray.origin[i]) * ray.invDirection[i];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        tmin = std::max(tmin, t0);
+        tmax = std::min(tmax, t1);
+        if (tmin > tmax)
+            return false;
+    }
+
+    entry = tmin;
+    return true;
+}
+
+/// the distance a node must be closer than to contribute to the results
+Real getLimit(const RaySceneQueryResult& result, size_t maxResults)
+{
+    return maxResults && result.size() == maxResults ? result.front().distance : INF;
+}
+
+void addHit(RaySceneQueryResult& result, size_t maxResults, MovableObject* movable, Real distance)
+{
+    RaySceneQueryResultEntry entry = {distance, movable, NULL};
+    if (!maxResults)
+    {
+        result.push_back(entry);
+        return;
+    }
+
+    // keep the nearest hits as a max heap
+    if (result.size() == maxResults)
+    {
+        if (!(entry < result.front()))
+            return;
+        std::pop_heap(result.begin(), result.end());
+        result.pop_back();
+    }
+    result.push_back(entry);
+    std::push_heap(result.begin(), result.end());
+}
+} // namespace
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy() : mBuildCost(0) {}
+
+void BoundingVolumeHierarchy::build(const std::vector<MovableObject*>& objects)
+{
+    mObjects = objects;
+    mBounds.resize(mObjects.size());
+    mOrder.clear();
+    mInfinite.clear();
+    mNodes.clear();
+
+    std::vector<Vector3> centres(mObjects.size(), Vector3::ZERO);
+    for (uint32 i = 0; i < mObjects.size(); i++)
+    {
+        const AxisAlignedBox& box = mBounds[i] = mObjects[i]->getWorldBoundingBox();
+        if (box.isInfinite())
+        {
+            mInfinite.push_back(i);
+            continue;
+        }
+
+        // objects with null bounds are kept, so refit can pick them up once they get bounds
+        if (box.isFinite())
+            centres[i] = box.getCenter();
+        mOrder.push_back(i);
+    }
+
+    if (!mOrder.empty())
+        buildNode(0, mOrder.size(), centres);
+
+    bool valid;
+    mBuildCost = refitNodes(valid);
+}
+
+uint32 BoundingVolumeHierarchy::buildNode(uint32 begin, uint32 end, const std::vector<Vector3>& centres)
+{
+    uint32 index = mNodes.size();
+    mNodes.push_back(BVHNode());
+
+    if (end - begin <= LEAF_SIZE)
+    {
+        mNodes[index].first = begin;
+        mNodes[index].count = end - begin;
+        mNodes[index].axis = 0;
+        return index;
+    }
+
+    // split at the median of the centres along the axis they spread the most
+    Vector3 min = centres[mOrder[begin]], max = min;
+    for (uint32 i = begin + 1; i < end; i++)
+    {
+        min.makeFloor(centres[mOrder[i]]);
+        max.makeCeil(centres[mOrder[i]]);
+    }
+    Vector3 extent = max - min;
+    uint16 axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+    uint32 mid = begin + (end - begin) / 2;
+    std::nth_element(mOrder.begin() + begin, mOrder.begin() + mid, mOrder.begin() + end,
+                     [&centres, axis](uint32 a, uint32 b) { return centres[a][axis] < centres[b][axis]; });
+
+    buildNode(begin, mid, centres);
+    uint32 second = buildNode(mid, end, centres);
+
+    mNodes[index].first = second;
+    mNodes[index].count = 0;
+    mNodes[index].axis = axis;
+    return index;
+}
+
+bool BoundingVolumeHierarchy::refit()
+{
+    // copy the bounds in object order, as the tree accesses them spatially ordered
+    for (size_t i = 0; i < mObjects.size(); i++)
+        mBounds[i] = mObjects[i]->getWorldBoundingBox();
+
+    for (auto i : mInfinite)
+    {
+        if (!mBounds[i].isInfinite())
+            return false;
+    }
+
+    bool valid;
+    Real cost = refitNodes(valid);
+    return valid && cost <= 2 * mBuildCost;
+}
+
+Real BoundingVolumeHierarchy::refitNodes(bool& valid)
+{
+    valid = true;
+    Real cost = 0;
+
+    // children are stored after their parents
+    for (size_t i = mNodes.size(); i-- > 0;)
+    {
+        BVHNode& node = mNodes[i];
+        if (!node.count)
+        {
+            const BVHNode& first = mNodes[i + 1];
+            const BVHNode& second = mNodes[node.first];
+            node.min = first.min;
+            node.min.makeFloor(second.min);
+            node.max = first.max;
+            node.max.makeCeil(second.max);
+
+            Vector3 size = node.max - node.min;
+            if (node.min.x <= node.max.x)
+                cost += size.x * size.y + size.y * size.z + size.z * size.x;
+            continue;
+        }
+
+        node.min = Vector3(INF);
+        node.max = Vector3(-INF);
+        for (uint32 j = node.first; j < node.first + node.count; j++)
+        {
+            const AxisAlignedBox& box = mBounds[mOrder[j]];
+            if (box.isInfinite())
+                valid = false;
+            if (!box.isFinite())
+                continue;
+            node.min.makeFloor(box.getMinimum());
+            node.max.makeCeil(box.getMaximum());
+        }
+
+        if (node.min.x > node.max.x)
+            continue;
+
+        // grow the leaves a bit, so rounding never culls a hit of the exact test
+        Real scale = std::max(node.min.absDotProduct(Vector3::UNIT_SCALE), node.max.absDotProduct(Vector3::UNIT_SCALE));
+        Vector3 margin(scale * std::numeric_limits<Real>::epsilon() * 16 + std::numeric_limits<Real>::min());
+        node.min -= margin;
+        node.max += margin;
+    }
+
+    return cost;
+}
+
+void BoundingVolumeHierarchy::findPairs(std::vector<std::pair<uint32, uint32>>& pairs) const
+{
+    pairs.clear();
+
+    auto addPair = [&pairs](uint32 a, uint32 b) { pairs.emplace_back(std::min(a, b), std::max(a, b)); };
+
+    // infinite bounds intersect everything but null bounds
+    for (size_t i = 0; i < mInfinite.size(); i++)
+    {
+        for (size_t j = i + 1; j < mInfinite.size(); j++)
+            addPair(mInfinite[i], mInfinite[j]);
+        for (auto j : mOrder)
+        {
+            if (!mBounds[j].isNull())
+                addPair(mInfinite[i], j);
+        }
+    }
+
+    if (mNodes.empty())
+        return;
+
+    // query the tree with the bounds of every object, keeping the pairs with a later object
+    std::vector<uint32> stack;
+    for (auto i : mOrder)
+    {
+        const AxisAlignedBox& box = mBounds[i];
+        if (!box.isFinite())
+            continue;
+
+        stack.push_back(0);
+        while (!stack.empty())
+        {
+            const BVHNode& node = mNodes[stack.back()];
+            uint32 index = stack.back();
+            stack.pop_back();
+
+            if (!overlapsNode(box, node.min, node.max))
+                continue;
+
+            if (!node.count)
+            {
+                stack.push_back(node.first);
+                stack.push_back(index + 1);
+                continue;
+            }
+
+            for (uint32 j = node.first; j < node.first + node.count; j++)
+            {
+                uint32 other = mOrder[j];
+                if (other > i && box.intersects(mBounds[other]))
+                    pairs.emplace_back(i, other);
+            }
+        }
+    }
+}
+
+void BoundingVolumeHierarchy::intersect(const Ray* rays, size_t count, size_t maxResults,
+                                        RaySceneQueryResult* results) const
+{
+    for (size_t i = 0; i < count; i++)
+        results[i].clear();
+
+    for (size_t i = 0; i < count; i += PACKET_SIZE)
+        intersectPacket(rays + i, std::min(PACKET_SIZE, count - i), maxResults, results + i);
+
+    if (!maxResults)
+        return;
+
+    for (size_t i = 0; i < count; i++)
+        std::sort_heap(results[i].begin(), results[i].end());
+}
+
+void BoundingVolumeHierarchy::intersectPacket(const Ray* rays, size_t count, size_t maxResults,
+                                              RaySceneQueryResult* results) const
+{
+    PacketRay packet[PACKET_SIZE];
+    for (size_t i = 0; i < count; i++)
+    {
+        packet[i].origin = rays[i].getOrigin();
+        packet[i].direction = rays[i].getDirection();
+        for (int j = 0; j < 3; j++)
+            packet[i].invDirection[j] = packet[i].direction[j] == 0 ? 0 : 1 / packet[i].direction[j];
+
+        // objects with infinite bounds are hit at the ray origin
+        for (auto j : mInfinite)
+            addHit(results[i], maxResults, mObjects[j], 0);
+    }
+
+    if (mNodes.empty())
+        return;
+
+    struct StackEntry
+    {
+        uint32 node;
+        uint32 rays;
+    };
+    // depth first traversal needs one entry per level plus one
+    StackEntry stack[64];
+    size_t stackSize = 0;
+    stack[stackSize++] = {0, (1u << count) - 1};
+
+    while (stackSize)
+    {
+        StackEntry entry = stack[--stackSize];
+        const BVHNode& node = mNodes[entry.node];
+
+        // the rays of the packet which hit the node and might still find a nearer object there
+        uint32 active = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            Real distance;
+            if ((entry.rays & (1u << i)) && intersectsNode(packet[i], node.min, node.max, distance) &&
+                distance <= getLimit(results[i], maxResults))
+                active |= 1u << i;
+        }
+        if (!active)
+            continue;
+
+        if (node.count)
+        {
+            for (uint32 j = node.first; j < node.first + node.count; j++)
+            {
+                const AxisAlignedBox& box = mBounds[mOrder[j]];
+                for (size_t i = 0; i < count; i++)
+                {
+                    if (!(active & (1u << i)))
+                        continue;
+                    RayTestResult hit = rays[i].intersects(box);
+                    if (hit.first)
+                        addHit(results[i], maxResults, mObjects[mOrder[j]], hit.second);
+                }
+            }
+            continue;
+        }
+
+        // visit the nearer child first, as seen by the first active ray
+        size_t first = 0;
+        while (!(active & (1u << first)))
+            first++;
+        uint32 nearChild = entry.node + 1, farChild = node.first;
+        if (packet[first].direction[node.axis] < 0)
+            std::swap(nearChild, farChild);
+
+        OgreAssertDbg(stackSize + 2 <= 64, "BVH too deep");
+        stack[stackSize++] = {farChild, active};
+        stack[stackSize++] = {nearChild, active};
+    }
+}
+} // namespace Ogre
@@ -0,0 +1,99 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#ifndef __BoundingVolumeHierarchy_H__
+#define __BoundingVolumeHierarchy_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreSceneQuery.h"
+
+namespace Ogre
+{
+/** \addtogroup Core
+ *  @{
+ */
+/** \addtogroup Scene
+ *  @{
+ */
+/** Bounding volume hierarchy over the world bounds of a set of MovableObjects
+
+    The tree is built once for a set of objects and afterwards only refitted to the current
+    bounds of the objects, which is linear in the number of objects and does not touch the
+    structure. If the objects moved too far from their original positions, the tree becomes
+    inefficient and refit asks for a rebuild.
+
+*/
+class BoundingVolumeHierarchy : public SceneMgtAlloc
+{
+public:
+    BoundingVolumeHierarchy();
+
+    /// Build the tree over the given objects, which must stay alive until the next build
+    void build(const std::vector<MovableObject*>& objects);
+
+    /** Update the node bounds to the current world bounds of the objects
+
+        @return false if the tree degraded and should be built again
+    */
+    bool refit();
+
+    /// The objects the tree was built for
+    const std::vector<MovableObject*>& getObjects() const { return mObjects; }
+
+    /** Find all pairs of objects with intersecting bounds
+
+        The results are the same as testing every pair with AxisAlignedBox::intersects.
+        @param pairs receives the indices of the objects into getObjects(), the lower index first
+    */
+    void findPairs(std::vector<std::pair<uint32, uint32>>& pairs) const;
+
+    /** Find the objects hit by the given rays
+
+        The results are the same as testing every object with Ray::intersects.
+        @param rays the rays to test
+        @param count number of rays
+        @param maxResults if not 0, only the nearest maxResults hits are returned, sorted by distance
+        @param results receives the hits of every ray, must have count elements
+    */
+    void intersect(const Ray* rays, size_t count, size_t maxResults, RaySceneQueryResult* results) const;
+
+private:
+    struct BVHNode
+    {
+        Vector3 min;
+        Vector3 max;
+        /// leaf: first index into mOrder, inner node: index of the second child
+        uint32 first;
+        /// number of objects in a leaf, 0 for inner nodes
+        uint16 count;
+        /// the axis the children were split along
+        uint16 axis;
+    };
+
+    uint32 buildNode(uint32 begin, uint32 end, const std::vector<Vector3>& centres);
+    /** update the node bounds bottom up
+
+        @param valid set to false if an object in a leaf got infinite bounds
+        @return the sum of the surface areas of the inner nodes
+    */
+    Real refitNodes(bool& valid);
+    void intersectPacket(const Ray* rays, size_t count, size_t maxResults, RaySceneQueryResult* results) const;
+
+    std::vector<MovableObject*> mObjects;
+    /// world bounds of mObjects at the last build or refit
+    std::vector<AxisAlignedBox> mBounds;
+    /// indices into mObjects of the objects with finite bounds, ordered by leaf
+    std::vector<uint32> mOrder;
+    /// objects with infinite bounds, which are hit by every ray
+    std::vector<uint32> mInfinite;
+    /// depth first order, so the first child of an inner node follows its parent
+    std::vector<BVHNode> mNodes;
+    Real mBuildCost;
+};
+/** @} */
+/** @} */
+} // namespace Ogre
+
+#endif
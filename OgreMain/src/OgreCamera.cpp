@@ -919,6 +919,31 @@ namespace Ogre {
         }
     }
     //-----------------------------------------------------------------------
+    void Camera::isVisible(const Vector3* centres, const Vector3* halfSizes, size_t count,
+                           uint32* visibility) const
+    {
+        if (mCullFrustum)
+        {
+            mCullFrustum->isVisible(centres, halfSizes, count, visibility);
+        }
+        else
+        {
+            Frustum::isVisible(centres, halfSizes, count, visibility);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void Camera::isVisible(const Sphere* spheres, size_t count, uint32* visibility) const
+    {
+        if (mCullFrustum)
+        {
+            mCullFrustum->isVisible(spheres, count, visibility);
+        }
+        else
+        {
+            Frustum::isVisible(spheres, count, visibility);
+        }
+    }
+    //-----------------------------------------------------------------------
     const Frustum::Corners& Camera::getWorldSpaceCorners(void) const
     {
         if (mCullFrustum)
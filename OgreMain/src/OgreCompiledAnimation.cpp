@@ -0,0 +1,223 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#include "OgreStableHeaders.h"
+#include "OgreCompiledAnimation.h"
+#include "OgreKeyFrame.h"
+#include "OgreSkeleton.h"
+#include "OgreBone.h"
+
+namespace Ogre
+{
+    //-----------------------------------------------------------------------
+    Quaternion CompiledAnimation::Pose::getRotation(size_t track) const
+    {
+        return Quaternion(getComponent(ROTATION_W)[track], getComponent(ROTATION_X)[track],
+                          getComponent(ROTATION_Y)[track], getComponent(ROTATION_Z)[track]);
+    }
+    //-----------------------------------------------------------------------
+    Vector3 CompiledAnimation::Pose::getTranslate(size_t track) const
+    {
+        return Vector3(getComponent(TRANSLATE_X)[track], getComponent(TRANSLATE_Y)[track],
+                       getComponent(TRANSLATE_Z)[track]);
+    }
+    //-----------------------------------------------------------------------
+    Vector3 CompiledAnimation::Pose::getScale(size_t track) const
+    {
+        return Vector3(getComponent(SCALE_X)[track], getComponent(SCALE_Y)[track], getComponent(SCALE_Z)[track]);
+    }
+    //-----------------------------------------------------------------------
+    CompiledAnimation::CompiledAnimation(const Animation* anim, Real sampleRate, bool quantise)
+        : mLength(anim->getLength()), mInterval(0), mNumSamples(1),
+          mRotationInterpolationMode(anim->getRotationInterpolationMode())
+    {
+        OgreAssert(sampleRate > 0, "sample rate must be positive");
+
+        std::vector<const NodeAnimationTrack*> tracks;
+        for (const auto& t : anim->_getNodeTrackList())
+        {
+            if (!t.second->getNumKeyFrames())
+                continue;
+            mHandles.push_back(t.first);
+            mUseShortestRotationPath.push_back(t.second->getUseShortestRotationPath());
+            tracks.push_back(t.second);
+        }
+
+        if (mLength > 0)
+        {
+            mNumSamples = size_t(std::ceil(mLength * sampleRate)) + 1;
+            mInterval = mLength / (mNumSamples - 1);
+        }
+
+        size_t numTracks = tracks.size();
+        size_t stride = NUM_COMPONENTS * numTracks;
+        mSamples.resize(mNumSamples * stride);
+        for (size_t s = 0; s < mNumSamples; ++s)
+        {
+            Real time = s + 1 < mNumSamples ? s * mInterval : mLength;
+            float* sample = &mSamples[s * stride];
+            for (size_t i = 0; i < numTracks; ++i)
+            {
+                TransformKeyFrame kf(0, time);
+                tracks[i]->getInterpolatedKeyFrame(TimeIndex(time), &kf);
+
+                // keep consecutive samples in the same hemisphere, so plain interpolation
+                // takes the shortest path
+                Quaternion q = kf.getRotation();
+                if (s > 0 && mUseShortestRotationPath[i])
+                {
+                    const float* prev = sample - stride;
+                    Quaternion prevQ(prev[ROTATION_W * numTracks + i], prev[ROTATION_X * numTracks + i],
+                                     prev[ROTATION_Y * numTracks + i], prev[ROTATION_Z * numTracks + i]);
+                    if (q.Dot(prevQ) < 0)
+                        q = -q;
+                }
+
+                const Vector3& translate = kf.getTranslate();
+                const Vector3& scale = kf.getScale();
+                const float values[NUM_COMPONENTS] = {
+                    float(q.x),         float(q.y),         float(q.z),         float(q.w),
+                    float(translate.x), float(translate.y), float(translate.z),
+                    float(scale.x),     float(scale.y),     float(scale.z)};
+                for (int c = 0; c < NUM_COMPONENTS; ++c)
+                    sample[c * numTracks + i] = values[c];
+            }
+        }
+
+        if (!quantise || mSamples.empty())
+            return;
+
+        // 16 bit steps within the range of each component of each track
+        mQuantisationOffset.resize(stride);
+        mQuantisationScale.resize(stride);
+        mQuantisedSamples.resize(mSamples.size());
+        for (size_t j = 0; j < stride; ++j)
+        {
+            float minVal = mSamples[j], maxVal = mSamples[j];
+            for (size_t s = 1; s < mNumSamples; ++s)
+            {
+                minVal = std::min(minVal, mSamples[s * stride + j]);
+                maxVal = std::max(maxVal, mSamples[s * stride + j]);
+            }
+            float step = (maxVal - minVal) / 65535;
+            mQuantisationOffset[j] = minVal;
+            mQuantisationScale[j] = step;
+            for (size_t s = 0; s < mNumSamples; ++s)
+            {
+                float q = step > 0 ? std::round((mSamples[s * stride + j] - minVal) / step) : 0;
+                mQuantisedSamples[s * stride + j] = uint16(std::min(q, 65535.0f));
+            }
+        }
+        mSamples.clear();
+        mSamples.shrink_to_fit();
+    }
+    //-----------------------------------------------------------------------
+    template <typename T>
+    void CompiledAnimation::interpolate(const T* a, const T* b, float t, float* out) const
+    {
+        size_t count = NUM_COMPONENTS * mHandles.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            float va = float(a[i]);
+            out[i] = va + (float(b[i]) - va) * t;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void CompiledAnimation::samplePose(Real timePos, Pose& pose) const
+    {
+        size_t numTracks = mHandles.size();
+        size_t stride = NUM_COMPONENTS * numTracks;
+        pose.numTracks = numTracks;
+        pose.data.resize(stride);
+        if (!numTracks)
+            return;
+
+        // Wrap time
+        if (timePos > mLength && mLength > 0)
+            timePos = std::fmod(timePos, mLength);
+
+        // the samples around the time
+        size_t first = 0;
+        float t = 0;
+        if (mNumSamples > 1)
+        {
+            Real pos = Math::Clamp<Real>(timePos / mInterval, 0, Real(mNumSamples - 1));
+            first = std::min(size_t(pos), mNumSamples - 2);
+            t = float(pos - first);
+        }
+        size_t second = std::min(first + 1, mNumSamples - 1);
+
+        float* out = pose.data.data();
+        if (isQuantised())
+        {
+            interpolate(&mQuantisedSamples[first * stride], &mQuantisedSamples[second * stride], t, out);
+            const float* offset = mQuantisationOffset.data();
+            const float* scale = mQuantisationScale.data();
+            for (size_t i = 0; i < stride; ++i)
+                out[i] = offset[i] + scale[i] * out[i];
+        }
+        else
+        {
+            interpolate(&mSamples[first * stride], &mSamples[second * stride], t, out);
+        }
+
+        // renormalise the interpolated rotations
+        float* x = out + ROTATION_X * numTracks;
+        float* y = out + ROTATION_Y * numTracks;
+        float* z = out + ROTATION_Z * numTracks;
+        float* w = out + ROTATION_W * numTracks;
+        for (size_t i = 0; i < numTracks; ++i)
+        {
+            float len = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i] + w[i] * w[i]);
+            float inv = len > 0 ? 1 / len : 0;
+            x[i] *= inv;
+            y[i] *= inv;
+            z[i] *= inv;
+            w[i] *= inv;
+        }
+    }
+    //-----------------------------------------------------------------------
+    void CompiledAnimation::apply(Skeleton* skeleton, Real timePos, float weight,
+                                  const AnimationState::BoneBlendMask* blendMask, Real scl) const
+    {
+        // reused, as skeletons of different entities might be animated concurrently
+        static thread_local Pose pose;
+        samplePose(timePos, pose);
+
+        for (size_t i = 0; i < mHandles.size(); ++i)
+        {
+            Bone* b = skeleton->getBone(mHandles[i]);
+            float w = blendMask ? (*blendMask)[b->getHandle()] * weight : weight;
+            // as NodeAnimationTrack::applyToNode
+            if (!w)
+                continue;
+
+            b->translate(pose.getTranslate(i) * w * scl);
+
+            Quaternion rotation = pose.getRotation(i);
+            bool shortestPath = mUseShortestRotationPath[i];
+            if (mRotationInterpolationMode == Animation::RIM_LINEAR)
+                b->rotate(Quaternion::nlerp(w, Quaternion::IDENTITY, rotation, shortestPath));
+            else
+                b->rotate(Quaternion::Slerp(w, Quaternion::IDENTITY, rotation, shortestPath));
+
+            Vector3 scale = pose.getScale(i);
+            if (scale != Vector3::UNIT_SCALE)
+            {
+                if (scl != 1.0f)
+                    scale = Vector3::UNIT_SCALE + (scale - Vector3::UNIT_SCALE) * scl;
+                else if (w != 1.0f)
+                    scale = Vector3::UNIT_SCALE + (scale - Vector3::UNIT_SCALE) * w;
+            }
+            b->scale(scale);
+        }
+    }
+    //-----------------------------------------------------------------------
+    size_t CompiledAnimation::getSampleMemoryUsage() const
+    {
+        return mSamples.size() * sizeof(float) + mQuantisedSamples.size() * sizeof(uint16) +
+               (mQuantisationOffset.size() + mQuantisationScale.size()) * sizeof(float);
+    }
+}
@@ -27,6 +27,14 @@ THE SOFTWARE.
 */
 #include "OgreStableHeaders.h"
 
+#if OGRE_PLATFORM != OGRE_PLATFORM_WIN32 && OGRE_PLATFORM != OGRE_PLATFORM_WINRT
+#   define OGRE_USE_MMAP
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
 namespace Ogre {
 
     //-----------------------------------------------------------------------
@@ -467,6 +475,77 @@ namespace Ogre {
     }
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
+    MmapDataStream::Mapping MmapDataStream::mapFile(const String& path)
+    {
+        Mapping mapping = {NULL, 0};
+#ifdef OGRE_USE_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "Cannot open file: " + path);
+
+        struct stat tagStat;
+        if (fstat(fd, &tagStat) != 0)
+        {
+            ::close(fd);
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "Cannot open file: " + path);
+        }
+
+        mapping.size = tagStat.st_size;
+        // mapping an empty file is an error
+        if (mapping.size)
+        {
+            mapping.data = mmap(NULL, mapping.size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping.data == MAP_FAILED)
+            {
+                ::close(fd);
+                OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "Cannot map file: " + path);
+            }
+        }
+        // the mapping stays valid after closing the descriptor
+        ::close(fd);
+#else
+        std::ifstream file(path.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+        if (file.fail())
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "Cannot open file: " + path);
+
+        mapping.size = size_t(file.tellg());
+        file.seekg(0);
+        mapping.data = OGRE_MALLOC(mapping.size, MEMCATEGORY_GENERAL);
+        file.read(static_cast<char*>(mapping.data), mapping.size);
+#endif
+        return mapping;
+    }
+    //-----------------------------------------------------------------------
+    MmapDataStream::MmapDataStream(const String& name, const Mapping& mapping)
+        : MemoryDataStream(name, mapping.data, mapping.size, false, true), mMapped(true)
+    {
+    }
+    //-----------------------------------------------------------------------
+    MmapDataStream::MmapDataStream(const String& path, const String& name)
+        : MmapDataStream(name.empty() ? path : name, mapFile(path))
+    {
+    }
+    //-----------------------------------------------------------------------
+    MmapDataStream::~MmapDataStream()
+    {
+        close();
+    }
+    //-----------------------------------------------------------------------
+    void MmapDataStream::close(void)
+    {
+        if (mMapped && getPtr())
+        {
+#ifdef OGRE_USE_MMAP
+            munmap(getPtr(), mSize);
+#else
+            OGRE_FREE(getPtr(), MEMCATEGORY_GENERAL);
+#endif
+        }
+        mMapped = false;
+        MemoryDataStream::close();
+    }
+    //-----------------------------------------------------------------------
+    //-----------------------------------------------------------------------
     FileStreamDataStream::FileStreamDataStream(std::ifstream* s, bool freeOnClose)
         : DataStream(), mInStream(s), mFStreamRO(s), mFStream(0), mFreeOnClose(freeOnClose)
     {
@@ -26,11 +26,12 @@ THE SOFTWARE.
 -----------------------------------------------------------------------------
 */
 #include "OgreStableHeaders.h"
+#include "OgreBoundingVolumeHierarchy.h"
 
 namespace Ogre {
     //---------------------------------------------------------------------
     DefaultIntersectionSceneQuery::DefaultIntersectionSceneQuery(SceneManager* creator)
-    : IntersectionSceneQuery(creator)
+    : IntersectionSceneQuery(creator), mHierarchy(new BoundingVolumeHierarchy())
     {
     }
     //---------------------------------------------------------------------
@@ -40,74 +41,34 @@ namespace Ogre {
     //---------------------------------------------------------------------
     void DefaultIntersectionSceneQuery::execute(IntersectionSceneQueryListener* listener)
     {
+        mObjects.clear();
+
         // Iterate over all movable types
-        const auto& factories = Root::getSingleton().getMovableObjectFactories();
-        auto factIt = factories.begin();
-        while(factIt != factories.end())
+        for(const auto& factIt : Root::getSingleton().getMovableObjectFactories())
         {
-            const auto& objsA = mParentSceneMgr->getMovableObjects((factIt++)->first);
-            auto objItA = objsA.begin();
-            while (objItA != objsA.end())
+            for (const auto& objIt : mParentSceneMgr->getMovableObjects(factIt.first))
             {
-                MovableObject* a = (objItA++)->second;
-                // skip entire section if type doesn't match
+                MovableObject* a = objIt.second;
+                // skip whole group if type doesn't match
                 if (!(a->getTypeFlags() & mQueryTypeMask))
                     break;
 
-                // Skip if a does not pass the mask
-                if (!(a->getQueryFlags() & mQueryMask) || !a->isInScene())
-                    continue;
-
-                // Check against later objects in the same group
-                auto objItB = objItA;
-                while (objItB != objsA.end())
-                {
-                    MovableObject* b = (objItB++)->second;
-
-                    // Apply mask to b (both must pass)
-                    if ((b->getQueryFlags() & mQueryMask) && b->isInScene())
-                    {
-                        const AxisAlignedBox& box1 = a->getWorldBoundingBox();
-                        const AxisAlignedBox& box2 = b->getWorldBoundingBox();
-
-                        if (box1.intersects(box2))
-                        {
-                            if (!listener->queryResult(a, b)) return;
-                        }
-                    }
-                }
-                // Check  against later groups
-                auto factItLater = factIt;
-                while (factItLater != factories.end())
-                {
-                    for (const auto& objItC :
-                         mParentSceneMgr->getMovableObjects((factItLater++)->first))
-                    {
-                        MovableObject* c = objItC.second;
-                        // skip entire section if type doesn't match
-                        if (!(c->getTypeFlags() & mQueryTypeMask))
-                            break;
-
-                        // Apply mask to c (both must pass)
-                        if ((c->getQueryFlags() & mQueryMask) && c->isInScene())
-                        {
-                            const AxisAlignedBox& box1 = a->getWorldBoundingBox();
-                            const AxisAlignedBox& box2 = c->getWorldBoundingBox();
-
-                            if (box1.intersects(box2))
-                            {
-                                if (!listener->queryResult(a, c)) return;
-                            }
-                        }
-                    }
-
-                }
-
+                if ((a->getQueryFlags() & mQueryMask) && a->isInScene())
+                    mObjects.push_back(a);
             }
+        }
 
+        if (mObjects != mHierarchy->getObjects() || !mHierarchy->refit())
+            mHierarchy->build(mObjects);
+        mHierarchy->findPairs(mPairs);
 
+        // report in the order of a brute force search, as the listener might stop early
+        std::sort(mPairs.begin(), mPairs.end());
+        for (const auto& p : mPairs)
+        {
+            if (!listener->queryResult(mObjects[p.first], mObjects[p.second]))
+                return;
         }
-
     }
     //---------------------------------------------------------------------
     DefaultAxisAlignedBoxSceneQuery::
@@ -142,7 +103,8 @@ namespace Ogre {
     }
     //---------------------------------------------------------------------
     DefaultRaySceneQuery::
-    DefaultRaySceneQuery(SceneManager* creator) : RaySceneQuery(creator)
+    DefaultRaySceneQuery(SceneManager* creator)
+    : RaySceneQuery(creator), mHierarchy(new BoundingVolumeHierarchy())
     {
     }
     //---------------------------------------------------------------------
@@ -150,13 +112,9 @@ namespace Ogre {
     {
     }
     //---------------------------------------------------------------------
-    void DefaultRaySceneQuery::execute(RaySceneQueryListener* listener)
+    void DefaultRaySceneQuery::updateHierarchy()
     {
-        // Note that because we have no scene partitioning, we actually
-        // perform a complete scene search even if restricted results are
-        // requested; smarter scene manager queries can utilise the paritioning 
-        // of the scene in order to reduce the number of intersection tests 
-        // required to fulfil the query
+        mObjects.clear();
 
         // Iterate over all movable types
         for(const auto& factIt : Root::getSingleton().getMovableObjectFactories())
@@ -169,18 +127,46 @@ namespace Ogre {
                     break;
 
                 if ((a->getQueryFlags() & mQueryMask) && a->isInScene())
-                {
-                    // Do ray / box test
-                    std::pair<bool, Real> result = mRay.intersects(a->getWorldBoundingBox());
-
-                    if (result.first)
-                    {
-                        if (!listener->queryResult(a, result.second)) return;
-                    }
-                }
+                    mObjects.push_back(a);
             }
         }
 
+        if (mObjects != mHierarchy->getObjects() || !mHierarchy->refit())
+            mHierarchy->build(mObjects);
+    }
+    //---------------------------------------------------------------------
+    void DefaultRaySceneQuery::execute(RaySceneQueryListener* listener)
+    {
+        updateHierarchy();
+
+        // execute() sorts and truncates the results itself, so only the nearest hits are needed
+        size_t maxResults = listener == this && getSortByDistance() ? getMaxResults() : 0;
+        mHierarchy->intersect(&mRay, 1, maxResults, &mHits);
+
+        // report the nearest hits first, as the listener might stop early
+        if (!maxResults)
+            std::sort(mHits.begin(), mHits.end());
+
+        for (const auto& hit : mHits)
+        {
+            if (!listener->queryResult(hit.movable, hit.distance)) return;
+        }
+    }
+    //---------------------------------------------------------------------
+    void DefaultRaySceneQuery::execute(const std::vector<Ray>& rays, std::vector<RaySceneQueryResult>& results)
+    {
+        updateHierarchy();
+
+        size_t maxResults = getSortByDistance() ? getMaxResults() : 0;
+        results.resize(rays.size());
+        mHierarchy->intersect(rays.data(), rays.size(), maxResults, results.data());
+
+        // limited results are sorted already
+        if (!getSortByDistance() || maxResults)
+            return;
+
+        for (auto& result : results)
+            std::sort(result.begin(), result.end());
     }
     //---------------------------------------------------------------------
     DefaultSphereSceneQuery::
@@ -61,10 +61,18 @@ namespace Ogre
         if (mWorkerRenderSystemAccess)
             Root::getSingleton().getRenderSystem()->preExtraThreadsStarted();
 
+        // one task queue per worker, the others are stolen from when it runs empty
+        createTaskQueues(mWorkerThreadCount);
+
         mNumThreadsRegisteredWithRS = 0;
         for (size_t i = 0; i < mWorkerThreadCount; ++i)
         {
-            OGRE_THREAD_CREATE(t, [this]() { _threadMain(); });
+            auto threadMain = [this, i]()
+            {
+                bindThreadToTaskQueue(i);
+                _threadMain();
+            };
+            OGRE_THREAD_CREATE(t, threadMain);
             mWorkers.push_back(t);
         }
 
@@ -104,11 +112,19 @@ namespace Ogre
             OGRE_THREAD_CURRENT_ID
             << ".";
 
-        mShuttingDown = true;
-
 #if OGRE_THREAD_SUPPORT
+        {
+            // set while locked, so no worker misses the wake up below between checking and waiting
+            OGRE_WQ_LOCK_MUTEX(mRequestMutex);
+            mShuttingDown = true;
+        }
         // wake all threads (they should check shutting down as first thing after wait)
         OGRE_THREAD_NOTIFY_ALL(mRequestCondition);
+#else
+        mShuttingDown = true;
+#endif
+
+#if OGRE_THREAD_SUPPORT
 
         // all our threads should have been woken now, so join
         for (WorkerThreadList::iterator i = mWorkers.begin(); i != mWorkers.end(); ++i)
@@ -124,8 +140,14 @@ namespace Ogre
     //---------------------------------------------------------------------
     void DefaultWorkQueue::notifyWorkers()
     {
+        // busy workers pick the task up without being woken
+        if (mNumWaitingWorkers == 0)
+            return;
+
+        // lock, so the notification can not slip in between a worker checking and waiting
+        OGRE_WQ_LOCK_MUTEX(mRequestMutex);
         // wake up waiting thread
-            OGRE_THREAD_NOTIFY_ONE(mRequestCondition);
+        OGRE_THREAD_NOTIFY_ONE(mRequestCondition);
     }
 
     //---------------------------------------------------------------------
@@ -134,14 +156,14 @@ namespace Ogre
 #if OGRE_THREAD_SUPPORT
         // Lock; note that OGRE_THREAD_WAIT will free the lock
             OGRE_WQ_LOCK_MUTEX_NAMED(mRequestMutex, queueLock);
-        if (mTasks.empty())
+        ++mNumWaitingWorkers;
+        while (mNumPendingTasks == 0 && !mShuttingDown)
         {
             // frees lock and suspends the thread
             OGRE_THREAD_WAIT(mRequestCondition, mRequestMutex, queueLock);
         }
-        // When we get back here, it's because we've been notified 
-        // and thus the thread has been woken up. Lock has also been
-        // re-acquired, but we won't use it. It's safe to try processing and fail
+        --mNumWaitingWorkers;
+        // It's safe to try processing and fail
         // if another thread has got in first and grabbed the request
 #endif
 
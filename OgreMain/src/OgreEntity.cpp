@@ -746,6 +746,17 @@ namespace Ogre {
         return true;
     }
     //-----------------------------------------------------------------------
+    void Entity::softwareVertexBlend(const VertexData* sourceVertexData, const VertexData* targetVertexData,
+                                     const Affine3* const* blendMatrices, size_t numMatrices, bool blendNormals)
+    {
+        // deferred, if the scene manager collects the software skinning of this frame
+        if (mManager &&
+            mManager->_queueSoftwareVertexBlend(sourceVertexData, targetVertexData, blendMatrices, numMatrices,
+                                                blendNormals))
+            return;
+        Mesh::softwareVertexBlend(sourceVertexData, targetVertexData, blendMatrices, numMatrices, blendNormals);
+    }
+    //-----------------------------------------------------------------------
     void Entity::updateAnimation(void)
     {
         // Do nothing if not initialised yet
@@ -835,7 +846,7 @@ namespace Ogre {
                         Mesh::prepareMatricesForVertexBlend(blendMatrices,
                                                             mBoneMatrices, mMesh->sharedBlendIndexToBoneIndexMap);
                         // Blend, taking source from either mesh data or morph data
-                        Mesh::softwareVertexBlend(
+                        softwareVertexBlend(
                             (mMesh->getSharedVertexDataAnimationType() != VAT_NONE) ?
                             mSoftwareVertexAnimVertexData.get() : mMesh->sharedVertexData,
                             mSkelAnimVertexData.get(),
@@ -855,7 +866,7 @@ namespace Ogre {
                             Mesh::prepareMatricesForVertexBlend(blendMatrices,
                                                                 mBoneMatrices, se->mSubMesh->blendIndexToBoneIndexMap);
                             // Blend, taking source from either mesh data or morph data
-                            Mesh::softwareVertexBlend(
+                            softwareVertexBlend(
                                 (se->getSubMesh()->getVertexAnimationType() != VAT_NONE)?
                                 se->mSoftwareVertexAnimVertexData.get() : se->mSubMesh->vertexData,
                                 se->mSkelAnimVertexData.get(),
@@ -116,6 +116,7 @@ namespace {
     };
 
     bool gIgnoreHidden = true;
+    bool gUseMemoryMapping = false;
 }
 
     //-----------------------------------------------------------------------
@@ -338,6 +339,8 @@ namespace {
         std::ios::openmode mode = std::ios::in | std::ios::binary;
 
         if(!readOnly) mode |= std::ios::out;
+        else if (gUseMemoryMapping)
+            return std::make_shared<MmapDataStream>(concatenate_path(mName, filename), filename);
 
         return _openFileStream(concatenate_path(mName, filename), mode, filename);
     }
@@ -569,4 +572,14 @@ namespace {
     {
         return gIgnoreHidden;
     }
+
+    void FileSystemArchiveFactory::setUseMemoryMapping(bool useMapping)
+    {
+        gUseMemoryMapping = useMapping;
+    }
+
+    bool FileSystemArchiveFactory::getUseMemoryMapping()
+    {
+        return gUseMemoryMapping;
+    }
 }
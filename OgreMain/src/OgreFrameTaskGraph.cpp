@@ -0,0 +1,221 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#include "OgreStableHeaders.h"
+#include "OgreFrameTaskGraph.h"
+#include "OgreWorkQueue.h"
+#include "OgreTimer.h"
+
+namespace Ogre
+{
+#if OGRE_THREAD_SUPPORT
+/// shared with the tasks, as these might only get to run after run() returned
+struct FrameTaskGraph::RunState
+{
+    OGRE_WQ_MUTEX(mutex);
+    OGRE_WQ_THREAD_SYNCHRONISER(changed);
+    WorkQueue* queue;
+    std::vector<Job>* jobs;
+    /// number of uncompleted dependencies per job
+    std::vector<uint32> pending;
+    /// jobs which can be run by any thread
+    std::deque<JobId> ready;
+    /// jobs which must be run by the thread calling run()
+    std::deque<JobId> readyMain;
+    size_t remaining;
+    std::exception_ptr error;
+
+    /// mark the job as ready, must be locked
+    static void makeReady(const std::shared_ptr<RunState>& state, JobId id)
+    {
+        if ((*state->jobs)[id].mainThread)
+        {
+            state->readyMain.push_back(id);
+            return;
+        }
+
+        // every task runs one job, which is not necessarily the one it was added for
+        state->ready.push_back(id);
+        state->queue->addTask([state]() { runTask(state); }, WorkQueue::TP_HIGH);
+    }
+
+    /// take a ready job, must be locked
+    bool take(bool mainThread, JobId& id)
+    {
+        auto& from = mainThread && !readyMain.empty() ? readyMain : ready;
+        if (from.empty())
+            return false;
+        id = from.front();
+        from.pop_front();
+        return true;
+    }
+
+    /// run the job, must not be locked
+    void execute(JobId id)
+    {
+        Job& job = (*jobs)[id];
+        try
+        {
+            Timer timer;
+            job.func();
+            job.duration = timer.getMicroseconds();
+        }
+        catch (...)
+        {
+            OGRE_WQ_LOCK_MUTEX(mutex);
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+
+    /// release the jobs waiting for the completed one, must be locked
+    static void complete(const std::shared_ptr<RunState>& state, JobId id)
+    {
+        for (auto dependent : (*state->jobs)[id].dependents)
+        {
+            if (--state->pending[dependent] == 0)
+                makeReady(state, dependent);
+        }
+        state->remaining--;
+    }
+
+    static void runTask(const std::shared_ptr<RunState>& state)
+    {
+        JobId id;
+        {
+            OGRE_WQ_LOCK_MUTEX(state->mutex);
+            if (!state->take(false, id))
+                return;
+        }
+        state->execute(id);
+
+        OGRE_WQ_LOCK_MUTEX(state->mutex);
+        complete(state, id);
+        OGRE_THREAD_NOTIFY_ALL(state->changed);
+    }
+};
+#endif
+
+FrameTaskGraph::FrameTaskGraph() : mNumJobs(0), mLastRunDuration(0) {}
+
+FrameTaskGraph::~FrameTaskGraph() {}
+
+FrameTaskGraph::JobId FrameTaskGraph::addJob(const String& name, std::function<void()> func,
+                                             const std::vector<JobId>& dependencies, bool mainThread)
+{
+    JobId id = JobId(mJobs.size());
+    for (auto dep : dependencies)
+        getJob(dep); // throws if it does not exist
+    for (auto dep : dependencies)
+        mJobs[dep].dependents.push_back(id);
+
+    Job job = {name, std::move(func), {}, uint32(dependencies.size()), mainThread, false, 0};
+    mJobs.push_back(std::move(job));
+    mNumJobs++;
+    return id;
+}
+
+void FrameTaskGraph::removeJob(JobId id)
+{
+    const Job& job = getJob(id);
+    OgreAssert(job.dependents.empty(), "other jobs depend on this job");
+
+    for (auto& other : mJobs)
+    {
+        auto it = std::find(other.dependents.begin(), other.dependents.end(), id);
+        if (it != other.dependents.end())
+            other.dependents.erase(it);
+    }
+
+    mJobs[id] = Job{"", nullptr, {}, 0, false, true, 0};
+    mNumJobs--;
+}
+
+FrameTaskGraph::JobId FrameTaskGraph::findJob(const String& name) const
+{
+    for (size_t i = 0; i < mJobs.size(); i++)
+    {
+        if (!mJobs[i].removed && mJobs[i].name == name)
+            return JobId(i);
+    }
+    OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, "Job '" + name + "' not found");
+}
+
+const FrameTaskGraph::Job& FrameTaskGraph::getJob(JobId id) const
+{
+    if (id >= mJobs.size() || mJobs[id].removed)
+        OGRE_EXCEPT(Exception::ERR_ITEM_NOT_FOUND, "Job " + std::to_string(id) + " not found");
+    return mJobs[id];
+}
+
+uint64 FrameTaskGraph::getJobDuration(JobId id) const { return getJob(id).duration; }
+
+void FrameTaskGraph::run(WorkQueue* queue)
+{
+    Timer timer;
+
+    bool parallel = queue && queue->getWorkerThreadCount() > 0 && mNumJobs > 1;
+#if OGRE_THREAD_SUPPORT
+    parallel = parallel && !queue->isPaused() && queue->getRequestsAccepted();
+#else
+    parallel = false;
+#endif
+
+    if (!parallel)
+    {
+        // dependencies are added first, so the ids are in a valid order
+        for (auto& job : mJobs)
+        {
+            if (!job.removed)
+            {
+                Timer jobTimer;
+                job.func();
+                job.duration = jobTimer.getMicroseconds();
+            }
+        }
+        mLastRunDuration = timer.getMicroseconds();
+        return;
+    }
+
+#if OGRE_THREAD_SUPPORT
+    auto state = std::make_shared<RunState>();
+    state->queue = queue;
+    state->jobs = &mJobs;
+    state->pending.resize(mJobs.size());
+    state->remaining = mNumJobs;
+
+    {
+        OGRE_WQ_LOCK_MUTEX(state->mutex);
+        for (size_t i = 0; i < mJobs.size(); i++)
+        {
+            state->pending[i] = mJobs[i].numDependencies;
+            if (!mJobs[i].removed && !mJobs[i].numDependencies)
+                RunState::makeReady(state, JobId(i));
+        }
+    }
+
+    // run the main thread jobs and help the workers, until everything is completed
+    while (true)
+    {
+        JobId id;
+        {
+            OGRE_WQ_LOCK_MUTEX_NAMED(state->mutex, lock);
+            while (state->remaining && !state->take(true, id))
+                OGRE_THREAD_WAIT(state->changed, state->mutex, lock);
+            if (!state->remaining)
+                break;
+        }
+        state->execute(id);
+
+        OGRE_WQ_LOCK_MUTEX(state->mutex);
+        RunState::complete(state, id);
+    }
+
+    if (state->error)
+        std::rethrow_exception(state->error);
+#endif
+    mLastRunDuration = timer.getMicroseconds();
+}
+} // namespace Ogre
@@ -28,6 +28,7 @@ THE SOFTWARE.
 #include "OgreStableHeaders.h"
 #include "OgreHardwareVertexBuffer.h"
 #include "OgreMovablePlane.h"
+#include "OgreSIMDHelper.h"
 
 namespace Ogre {
 
@@ -216,6 +217,162 @@ namespace Ogre {
         return true;
     }
 
+#if __OGRE_HAVE_SSE || __OGRE_HAVE_NEON
+    static bool hasSIMD()
+    {
+#if __OGRE_HAVE_SSE
+        return PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_SSE;
+#else
+        return PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_NEON;
+#endif
+    }
+
+    /// culls four boxes at a time, returns the number of boxes processed
+    static size_t __OGRE_SIMD_ALIGN_ATTRIBUTE cullBoxesSIMD(const Plane* planes, int numPlanes,
+                                                            const Vector3* centres,
+                                                            const Vector3* halfSizes, size_t count,
+                                                            uint32* visibility)
+    {
+        __m128 nx[6], ny[6], nz[6], d[6], anx[6], any[6], anz[6];
+        for (int p = 0; p < numPlanes; ++p)
+        {
+            nx[p] = _mm_set1_ps(planes[p].normal.x);
+            ny[p] = _mm_set1_ps(planes[p].normal.y);
+            nz[p] = _mm_set1_ps(planes[p].normal.z);
+            d[p] = _mm_set1_ps(planes[p].d);
+            anx[p] = _mm_set1_ps(std::abs(planes[p].normal.x));
+            any[p] = _mm_set1_ps(std::abs(planes[p].normal.y));
+            anz[p] = _mm_set1_ps(std::abs(planes[p].normal.z));
+        }
+        const __m128 zero = _mm_setzero_ps();
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const float* c = centres[i].ptr();
+            const float* h = halfSizes[i].ptr();
+            __m128 cx = _mm_loadu_ps(c), cy = _mm_loadu_ps(c + 4), cz = _mm_loadu_ps(c + 8);
+            __m128 hx = _mm_loadu_ps(h), hy = _mm_loadu_ps(h + 4), hz = _mm_loadu_ps(h + 8);
+            __MM_TRANSPOSE4x3_PS(cx, cy, cz);
+            __MM_TRANSPOSE4x3_PS(hx, hy, hz);
+
+            // same as Plane::getSide(centre, halfSize) == NEGATIVE_SIDE
+            __m128 culled = zero;
+            for (int p = 0; p < numPlanes; ++p)
+            {
+                __m128 dist = _mm_add_ps(__MM_DOT3x3_PS(nx[p], ny[p], nz[p], cx, cy, cz), d[p]);
+                __m128 maxAbsDist = __MM_DOT3x3_PS(anx[p], any[p], anz[p], hx, hy, hz);
+                culled = _mm_or_ps(culled, _mm_cmplt_ps(dist, _mm_sub_ps(zero, maxAbsDist)));
+            }
+
+            uint32 visible = ~_mm_movemask_ps(culled) & 0xF;
+            visibility[i / 32] |= visible << (i % 32);
+        }
+        return i;
+    }
+
+    static size_t __OGRE_SIMD_ALIGN_ATTRIBUTE cullSpheresSIMD(const Plane* planes, int numPlanes,
+                                                              const Sphere* spheres, size_t count,
+                                                              uint32* visibility)
+    {
+        static_assert(sizeof(Sphere) == 4 * sizeof(float), "radius and centre must be packed");
+
+        __m128 nx[6], ny[6], nz[6], d[6];
+        for (int p = 0; p < numPlanes; ++p)
+        {
+            nx[p] = _mm_set1_ps(planes[p].normal.x);
+            ny[p] = _mm_set1_ps(planes[p].normal.y);
+            nz[p] = _mm_set1_ps(planes[p].normal.z);
+            d[p] = _mm_set1_ps(planes[p].d);
+        }
+        const __m128 zero = _mm_setzero_ps();
+
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            const float* s = reinterpret_cast<const float*>(spheres + i);
+            __m128 r = _mm_loadu_ps(s), cx = _mm_loadu_ps(s + 4), cy = _mm_loadu_ps(s + 8),
+                   cz = _mm_loadu_ps(s + 12);
+            __MM_TRANSPOSE4x4_PS(r, cx, cy, cz);
+
+            __m128 negRadius = _mm_sub_ps(zero, r);
+            __m128 culled = zero;
+            for (int p = 0; p < numPlanes; ++p)
+            {
+                __m128 dist = _mm_add_ps(__MM_DOT3x3_PS(nx[p], ny[p], nz[p], cx, cy, cz), d[p]);
+                culled = _mm_or_ps(culled, _mm_cmplt_ps(dist, negRadius));
+            }
+
+            uint32 visible = ~_mm_movemask_ps(culled) & 0xF;
+            visibility[i / 32] |= visible << (i % 32);
+        }
+        return i;
+    }
+#endif
+    //-----------------------------------------------------------------------
+    void Frustum::isVisible(const Vector3* centres, const Vector3* halfSizes, size_t count,
+                            uint32* visibility) const
+    {
+        // Make any pending updates to the calculated frustum planes
+        updateFrustumPlanes();
+
+        std::fill(visibility, visibility + (count + 31) / 32, 0);
+
+        // Skip far plane if infinite view frustum
+        int numPlanes = mFarDist == 0 ? 5 : 6;
+        Plane planes[6];
+        for (int p = 0, i = 0; p < 6; ++p)
+        {
+            if (p != FRUSTUM_PLANE_FAR || numPlanes == 6)
+                planes[i++] = mFrustumPlanes[p];
+        }
+
+        size_t i = 0;
+#if __OGRE_HAVE_SSE || __OGRE_HAVE_NEON
+        if (hasSIMD())
+            i = cullBoxesSIMD(planes, numPlanes, centres, halfSizes, count, visibility);
+#endif
+        for (; i < count; ++i)
+        {
+            bool visible = true;
+            for (int p = 0; p < numPlanes && visible; ++p)
+                visible = planes[p].getSide(centres[i], halfSizes[i]) != Plane::NEGATIVE_SIDE;
+
+            if (visible)
+                visibility[i / 32] |= 1u << (i % 32);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void Frustum::isVisible(const Sphere* spheres, size_t count, uint32* visibility) const
+    {
+        // Make any pending updates to the calculated frustum planes
+        updateFrustumPlanes();
+
+        std::fill(visibility, visibility + (count + 31) / 32, 0);
+
+        int numPlanes = mFarDist == 0 ? 5 : 6;
+        Plane planes[6];
+        for (int p = 0, i = 0; p < 6; ++p)
+        {
+            if (p != FRUSTUM_PLANE_FAR || numPlanes == 6)
+                planes[i++] = mFrustumPlanes[p];
+        }
+
+        size_t i = 0;
+#if __OGRE_HAVE_SSE || __OGRE_HAVE_NEON
+        if (hasSIMD())
+            i = cullSpheresSIMD(planes, numPlanes, spheres, count, visibility);
+#endif
+        for (; i < count; ++i)
+        {
+            bool visible = true;
+            for (int p = 0; p < numPlanes && visible; ++p)
+                visible = planes[p].getDistance(spheres[i].getCenter()) >= -spheres[i].getRadius();
+
+            if (visible)
+                visibility[i / 32] |= 1u << (i % 32);
+        }
+    }
     //-----------------------------------------------------------------------
     bool Frustum::isVisible(const Vector3& vert, FrustumPlane* culledBy) const
     {
@@ -32,10 +32,37 @@ THE SOFTWARE.
 #include "OgreHighLevelGpuProgramManager.h"
 #include "OgreUnifiedHighLevelGpuProgram.h"
 #include "OgreStreamSerialiser.h"
+#include "OgreFileSystemLayer.h"
+
+#include <chrono>
+#include <thread>
 
 namespace Ogre {
 namespace {
     uint32 CACHE_CHUNK_ID = StreamSerialiser::makeIdentifier("OGPC"); // Ogre Gpu Program cache
+    uint32 CACHE_FILE_ID = StreamSerialiser::makeIdentifier("OGMC"); // Ogre Gpu Microcode
+
+    /// header of the files in the microcode cache directory
+    struct MicrocodeFileHeader
+    {
+        uint32 fileId;
+        uint32 id;
+        /// hash of the microcode
+        uint64 hash[2];
+    };
+
+    /// microcode in a memory mapped cache file
+    class MicrocodeView : public MemoryDataStream
+    {
+        MemoryDataStreamPtr mFile;
+    public:
+        MicrocodeView(const MemoryDataStreamPtr& file)
+            : MemoryDataStream(file->getName(), file->getPtr() + sizeof(MicrocodeFileHeader),
+                               file->size() - sizeof(MicrocodeFileHeader), false, true),
+              mFile(file)
+        {
+        }
+    };
 
     String sNullLang = "null";
     class NullProgram : public GpuProgram
@@ -301,18 +328,109 @@ namespace {
         return rs->getName() + "_" + name;
     }
     //---------------------------------------------------------------------
+    String GpuProgramManager::getMicrocodeCachePath(uint32 id) const
+    {
+        // programs of different render systems can have the same id
+        RenderSystem* rs = Root::getSingleton().getRenderSystem();
+        String key = (rs ? rs->getName() : BLANKSTRING) + "_" + std::to_string(id);
+
+        uint64 hash[2];
+        MurmurHash3_128(key.data(), key.size(), 0, hash);
+        char name[33];
+        snprintf(name, sizeof(name), "%016llx%016llx", (unsigned long long)hash[0], (unsigned long long)hash[1]);
+        return mMicrocodeCacheDirectory + name + ".bin";
+    }
+    //---------------------------------------------------------------------
+    const GpuProgramManager::Microcode* GpuProgramManager::findMicrocode(uint32 id) const
+    {
+        auto it = mMicrocodeCache.find(id);
+        if (it != mMicrocodeCache.end())
+            return &it->second;
+
+        if (mMicrocodeCacheDirectory.empty())
+            return NULL;
+
+        String path = getMicrocodeCachePath(id);
+        if (!FileSystemLayer::fileExists(path))
+            return NULL;
+
+        MemoryDataStreamPtr file;
+        try
+        {
+            file = std::make_shared<MmapDataStream>(path);
+        }
+        catch (const Exception& e)
+        {
+            LogManager::getSingleton().logWarning("Could not read microcode: " + e.getDescription());
+            return NULL;
+        }
+
+        // a file of another id with the same hash or one written only partially is a miss
+        MicrocodeFileHeader header;
+        if (file->read(&header, sizeof(header)) != sizeof(header) || header.fileId != CACHE_FILE_ID ||
+            header.id != id)
+            return NULL;
+
+        uint64 hash[2];
+        MurmurHash3_128(file->getCurrentPtr(), file->size() - sizeof(header), 0, hash);
+        if (hash[0] != header.hash[0] || hash[1] != header.hash[1])
+        {
+            LogManager::getSingleton().logWarning("Corrupt microcode: " + path);
+            return NULL;
+        }
+
+        return &mMicrocodeCache.emplace(id, std::make_shared<MicrocodeView>(file)).first->second;
+    }
+    //---------------------------------------------------------------------
     bool GpuProgramManager::isMicrocodeAvailableInCache( uint32 id ) const
     {
-        return mMicrocodeCache.find(id) != mMicrocodeCache.end();
+        OGRE_WQ_LOCK_MUTEX(mMicrocodeCacheMutex);
+        return findMicrocode(id) != NULL;
     }
     //---------------------------------------------------------------------
     const GpuProgramManager::Microcode & GpuProgramManager::getMicrocodeFromCache( uint32 id ) const
     {
-        return mMicrocodeCache.find(id)->second;
+        OGRE_WQ_LOCK_MUTEX(mMicrocodeCacheMutex);
+        return *findMicrocode(id);
+    }
+    //---------------------------------------------------------------------
+    void GpuProgramManager::setMicrocodeCacheDirectory(const String& path)
+    {
+        OGRE_WQ_LOCK_MUTEX(mMicrocodeCacheMutex);
+        mMicrocodeCacheDirectory = path;
+        if (path.empty())
+            return;
+
+        if (path.back() != '/' && path.back() != '\\')
+            mMicrocodeCacheDirectory += '/';
+        FileSystemLayer::createDirectory(mMicrocodeCacheDirectory);
     }
     //---------------------------------------------------------------------
     void GpuProgramManager::addMicrocodeToCache( uint32 id, const GpuProgramManager::Microcode & microcode )
     {   
+        OGRE_WQ_LOCK_MUTEX(mMicrocodeCacheMutex);
+        if (!mMicrocodeCacheDirectory.empty())
+        {
+            MicrocodeFileHeader header = {CACHE_FILE_ID, id, {0, 0}};
+            MurmurHash3_128(microcode->getPtr(), microcode->size(), 0, header.hash);
+
+            // write to a file of this thread and rename it, so readers never see a partial file
+            String path = getMicrocodeCachePath(id);
+            String tmpPath = StringUtil::format(
+                "%s.%zx%llx.tmp", path.c_str(), std::hash<std::thread::id>()(std::this_thread::get_id()),
+                (unsigned long long)std::chrono::steady_clock::now().time_since_epoch().count());
+            std::ofstream file(tmpPath.c_str(), std::ios::binary);
+            file.write((const char*)&header, sizeof(header));
+            file.write((const char*)microcode->getPtr(), microcode->size());
+            file.close();
+
+            if (file.fail() || !FileSystemLayer::renameFile(tmpPath, path))
+            {
+                FileSystemLayer::removeFile(tmpPath);
+                LogManager::getSingleton().logWarning("Could not write microcode: " + path);
+            }
+        }
+
         auto foundIter = mMicrocodeCache.find(id);
         if ( foundIter == mMicrocodeCache.end() )
         {
@@ -329,6 +447,11 @@ namespace {
     //---------------------------------------------------------------------
     void GpuProgramManager::removeMicrocodeFromCache( uint32 id )
     {
+        OGRE_WQ_LOCK_MUTEX(mMicrocodeCacheMutex);
+        // e.g. the driver rejected it, so it must not be read again
+        if (!mMicrocodeCacheDirectory.empty())
+            FileSystemLayer::removeFile(getMicrocodeCachePath(id));
+
         auto foundIter = mMicrocodeCache.find(id);
 
         if (foundIter != mMicrocodeCache.end())
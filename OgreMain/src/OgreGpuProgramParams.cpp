@@ -1199,6 +1199,89 @@ namespace Ogre
         };
 
     }
+    //-----------------------------------------------------------------------------
+    uint8 GpuProgramParameters::deriveSources(GpuProgramParameters::AutoConstantType act)
+    {
+        switch(act)
+        {
+        case ACT_VERTEX_WINDING:
+        case ACT_PASS_ITERATION_NUMBER:
+
+            // not tracked by AutoParamDataSource
+            return 0;
+
+        case ACT_TIME:
+        case ACT_TIME_0_X:
+        case ACT_COSTIME_0_X:
+        case ACT_SINTIME_0_X:
+        case ACT_TANTIME_0_X:
+        case ACT_TIME_0_X_PACKED:
+        case ACT_TIME_0_1:
+        case ACT_COSTIME_0_1:
+        case ACT_SINTIME_0_1:
+        case ACT_TANTIME_0_1:
+        case ACT_TIME_0_1_PACKED:
+        case ACT_TIME_0_2PI:
+        case ACT_COSTIME_0_2PI:
+        case ACT_SINTIME_0_2PI:
+        case ACT_TANTIME_0_2PI:
+        case ACT_TIME_0_2PI_PACKED:
+        case ACT_FRAME_TIME:
+        case ACT_FPS:
+
+            return GPS_TIME;
+
+        case ACT_AMBIENT_LIGHT_COLOUR:
+        case ACT_FOG_COLOUR:
+        case ACT_FOG_PARAMS:
+        case ACT_POINT_PARAMS:
+        case ACT_SHADOW_COLOUR:
+
+            return GPS_SCENE;
+
+        case ACT_DERIVED_AMBIENT_LIGHT_COLOUR:
+        case ACT_DERIVED_SCENE_COLOUR:
+
+            return GPS_SCENE | GPS_PASS;
+
+        case ACT_SURFACE_AMBIENT_COLOUR:
+        case ACT_SURFACE_DIFFUSE_COLOUR:
+        case ACT_SURFACE_SPECULAR_COLOUR:
+        case ACT_SURFACE_EMISSIVE_COLOUR:
+        case ACT_SURFACE_SHININESS:
+        case ACT_SURFACE_ALPHA_REJECTION_VALUE:
+        case ACT_PASS_NUMBER:
+        case ACT_TEXTURE_SIZE:
+        case ACT_INVERSE_TEXTURE_SIZE:
+        case ACT_PACKED_TEXTURE_SIZE:
+        case ACT_TEXTURE_MATRIX:
+
+            return GPS_PASS;
+
+        case ACT_DERIVED_LIGHT_DIFFUSE_COLOUR:
+        case ACT_DERIVED_LIGHT_SPECULAR_COLOUR:
+        case ACT_DERIVED_LIGHT_DIFFUSE_COLOUR_ARRAY:
+        case ACT_DERIVED_LIGHT_SPECULAR_COLOUR_ARRAY:
+
+            return GPS_LIGHTS | GPS_PASS;
+
+        case ACT_MATERIAL_LOD_INDEX:
+
+            return GPS_OBJECT;
+
+        default:
+            break;
+        };
+
+        // everything else depends on the view, and on the object and lights as per its variability
+        uint16 variability = deriveVariability(act);
+        uint8 sources = GPS_CAMERA;
+        if (variability & GPV_PER_OBJECT)
+            sources |= GPS_OBJECT;
+        if (variability & GPV_LIGHTS)
+            sources |= GPS_LIGHTS;
+        return sources;
+    }
     //---------------------------------------------------------------------
     GpuLogicalIndexUse* GpuProgramParameters::getConstantLogicalIndexUse(
         size_t logicalIndex, size_t requestedSize, uint16 variability, BaseConstantType type)
@@ -1427,6 +1510,8 @@ namespace Ogre
                 ac.data = extraInfo;
                 ac.elementCount = elementSize;
                 ac.variability = variability;
+                ac.sources = deriveSources(acType);
+                ac.version = 0;
                 found = true;
                 break;
             }
@@ -1452,6 +1537,8 @@ namespace Ogre
                 ac.fData = rData;
                 ac.elementCount = elementSize;
                 ac.variability = variability;
+                ac.sources = deriveSources(acType);
+                ac.version = 0;
                 found = true;
                 break;
             }
@@ -1557,11 +1644,19 @@ namespace Ogre
         mActivePassIterationIndex = std::numeric_limits<size_t>::max();
 
         // Autoconstant index is not a physical index
-        for (const auto& ac : mAutoConstants)
+        for (auto& ac : mAutoConstants)
         {
             // Only update needed slots
             if (ac.variability & mask)
             {
+                // skip values derived from unchanged data
+                if (ac.sources)
+                {
+                    uint64 version = source->getVersion(ac.sources);
+                    if (version == ac.version)
+                        continue;
+                    ac.version = version;
+                }
 
                 switch(ac.paramType)
                 {
@@ -85,7 +85,7 @@ namespace Ogre
     //-----------------------------------------------------------------------
     Log::~Log()
     {
-        OGRE_LOCK_AUTO_MUTEX;
+        OGRE_WQ_LOCK_MUTEX(OGRE_AUTO_MUTEX_NAME);
         if (!mSuppressFile)
         {
             mLog.close();
@@ -95,7 +95,7 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void Log::logMessage( const String& message, LogMessageLevel lml, bool maskDebug )
     {
-        OGRE_LOCK_AUTO_MUTEX;
+        OGRE_WQ_LOCK_MUTEX(OGRE_AUTO_MUTEX_NAME);
         if (lml >= mLogLevel)
         {
             bool skipThisMessage = false;
@@ -151,34 +151,34 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void Log::setTimeStampEnabled(bool timeStamp)
     {
-        OGRE_LOCK_AUTO_MUTEX;
+        OGRE_WQ_LOCK_MUTEX(OGRE_AUTO_MUTEX_NAME);
         mTimeStamp = timeStamp;
     }
 
     //-----------------------------------------------------------------------
     void Log::setDebugOutputEnabled(bool debugOutput)
     {
-        OGRE_LOCK_AUTO_MUTEX;
+        OGRE_WQ_LOCK_MUTEX(OGRE_AUTO_MUTEX_NAME);
         mDebugOut = debugOutput;
     }
 
     //-----------------------------------------------------------------------
     void Log::setLogDetail(LoggingLevel ll)
     {
-        OGRE_LOCK_AUTO_MUTEX;
+        OGRE_WQ_LOCK_MUTEX(OGRE_AUTO_MUTEX_NAME);
         mLogLevel = LogMessageLevel(OGRE_LOG_THRESHOLD - ll);
     }
 
     void Log::setMinLogLevel(LogMessageLevel lml)
     {
-        OGRE_LOCK_AUTO_MUTEX;
+        OGRE_WQ_LOCK_MUTEX(OGRE_AUTO_MUTEX_NAME);
         mLogLevel = lml;
     }
 
     //-----------------------------------------------------------------------
     void Log::addListener(LogListener* listener)
     {
-        OGRE_LOCK_AUTO_MUTEX;
+        OGRE_WQ_LOCK_MUTEX(OGRE_AUTO_MUTEX_NAME);
         if (std::find(mListeners.begin(), mListeners.end(), listener) == mListeners.end())
             mListeners.push_back(listener);
     }
@@ -186,7 +186,7 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void Log::removeListener(LogListener* listener)
     {
-        OGRE_LOCK_AUTO_MUTEX;
+        OGRE_WQ_LOCK_MUTEX(OGRE_AUTO_MUTEX_NAME);
         mtLogListener::iterator i = std::find(mListeners.begin(), mListeners.end(), listener);
         if (i != mListeners.end())
             mListeners.erase(i);
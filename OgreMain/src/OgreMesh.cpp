@@ -209,8 +209,9 @@ namespace Ogre {
             ResourceGroupManager::getSingleton().openResource(
                 mName, mGroup, this);
  
-        // fully prebuffer into host RAM
-        mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
+        // fully prebuffer into host RAM, unless already there
+        if (!dynamic_cast<MemoryDataStream*>(mFreshFromDisk.get()))
+            mFreshFromDisk = DataStreamPtr(OGRE_NEW MemoryDataStream(mName,mFreshFromDisk));
     }
     //-----------------------------------------------------------------------
     void Mesh::unprepareImpl()
@@ -1798,14 +1799,34 @@ namespace Ogre {
         const Affine3* const* blendMatrices, size_t numMatrices,
         bool blendNormals)
     {
+        // at most source positions, normals, indices, weights and target positions, normals
+        HardwareBufferLockGuard locks[6];
+        size_t numLocks = 0;
+        auto info = prepareSoftwareVertexBlend(sourceVertexData, targetVertexData, blendNormals,
+            [&locks, &numLocks](HardwareBuffer* buf, HardwareBuffer::LockOptions options)
+            {
+                for (size_t i = 0; i < numLocks; ++i)
+                {
+                    if (locks[i].pBuf == buf)
+                        return locks[i].pData;
+                }
+                locks[numLocks].lock(buf, options);
+                return locks[numLocks++].pData;
+            });
+
+        info.blend(blendMatrices, 0, info.numVertices);
+    }
+    //---------------------------------------------------------------------
+    Mesh::SoftwareVertexBlendInfo Mesh::prepareSoftwareVertexBlend(const VertexData* sourceVertexData,
+        const VertexData* targetVertexData, bool blendNormals, const LockBufferFunction& lockBuffer)
+    {
+        SoftwareVertexBlendInfo info = {};
         float *pSrcPos = 0;
         float *pSrcNorm = 0;
         float *pDestPos = 0;
         float *pDestNorm = 0;
         float *pBlendWeight = 0;
         unsigned char* pBlendIdx = 0;
-        size_t srcNormStride = 0;
-        size_t destNormStride = 0;
 
         // Get elements for source
         auto srcElemPos = sourceVertexData->vertexDeclaration->findElementBySemantic(VES_POSITION);
@@ -1828,76 +1849,79 @@ namespace Ogre {
         HardwareVertexBufferSharedPtr destPosBuf = targetVertexData->vertexBufferBinding->getBuffer(destElemPos->getSource());
 
         // Lock source buffers for reading
-        HardwareBufferLockGuard srcPosLock(srcPosBuf, HardwareBuffer::HBL_READ_ONLY);
-        srcElemPos->baseVertexPointerToElement(srcPosLock.pData, &pSrcPos);
+        srcElemPos->baseVertexPointerToElement(lockBuffer(srcPosBuf.get(), HardwareBuffer::HBL_READ_ONLY), &pSrcPos);
 
         // Do we have normals and want to blend them?
         bool includeNormals = blendNormals && srcElemNorm && destElemNorm;
         HardwareVertexBufferSharedPtr destNormBuf;
-        HardwareBufferLockGuard srcNormLock;
         if (includeNormals)
         {
             // Get buffers for source
             srcNormBuf = sourceVertexData->vertexBufferBinding->getBuffer(srcElemNorm->getSource());
-            srcNormStride = srcNormBuf->getVertexSize();
+            info.srcNormStride = srcNormBuf->getVertexSize();
             // Get buffers for target
             destNormBuf = targetVertexData->vertexBufferBinding->getBuffer(destElemNorm->getSource());
-            destNormStride = destNormBuf->getVertexSize();
+            info.destNormStride = destNormBuf->getVertexSize();
 
-            if (srcNormBuf != srcPosBuf)
-            {
-                // Different buffer
-                srcNormLock.lock(srcNormBuf, HardwareBuffer::HBL_READ_ONLY);
-            }
-            srcElemNorm->baseVertexPointerToElement(srcNormLock.pData ? srcNormLock.pData : srcPosLock.pData, &pSrcNorm);
+            srcElemNorm->baseVertexPointerToElement(lockBuffer(srcNormBuf.get(), HardwareBuffer::HBL_READ_ONLY),
+                                                    &pSrcNorm);
         }
 
         // Indices must be 4 bytes
         assert(srcElemBlendIndices->getType() == VET_UBYTE4 && "Blend indices must be VET_UBYTE4");
-        HardwareBufferLockGuard srcIdxLock(srcIdxBuf, HardwareBuffer::HBL_READ_ONLY);
-        srcElemBlendIndices->baseVertexPointerToElement(srcIdxLock.pData, &pBlendIdx);
-        HardwareBufferLockGuard srcWeightLock;
-        if (srcWeightBuf != srcIdxBuf)
-        {
-            // Lock buffer
-            srcWeightLock.lock(srcWeightBuf, HardwareBuffer::HBL_READ_ONLY);
-        }
-        srcElemBlendWeights->baseVertexPointerToElement(srcWeightLock.pData ? srcWeightLock.pData : srcIdxLock.pData, &pBlendWeight);
-        unsigned short numWeightsPerVertex = VertexElement::getTypeCount(srcElemBlendWeights->getType());
+        srcElemBlendIndices->baseVertexPointerToElement(lockBuffer(srcIdxBuf.get(), HardwareBuffer::HBL_READ_ONLY),
+                                                        &pBlendIdx);
+        srcElemBlendWeights->baseVertexPointerToElement(
+            lockBuffer(srcWeightBuf.get(), HardwareBuffer::HBL_READ_ONLY), &pBlendWeight);
+        info.numWeightsPerVertex = VertexElement::getTypeCount(srcElemBlendWeights->getType());
 
         // Lock destination buffers for writing
-        HardwareBufferLockGuard destPosLock(destPosBuf,
+        void* destPosData = lockBuffer(destPosBuf.get(),
             (destNormBuf != destPosBuf && destPosBuf->getVertexSize() == destElemPos->getSize()) ||
             (destNormBuf == destPosBuf && destPosBuf->getVertexSize() == destElemPos->getSize() + destElemNorm->getSize()) ?
             HardwareBuffer::HBL_DISCARD : HardwareBuffer::HBL_NORMAL);
-        destElemPos->baseVertexPointerToElement(destPosLock.pData, &pDestPos);
-        HardwareBufferLockGuard destNormLock;
+        destElemPos->baseVertexPointerToElement(destPosData, &pDestPos);
         if (includeNormals)
         {
+            void* destNormData = destPosData;
             if (destNormBuf != destPosBuf)
             {
-                destNormLock.lock(destNormBuf, destNormBuf->getVertexSize() == destElemNorm->getSize()
-                                                   ? HardwareBuffer::HBL_DISCARD
-                                                   : HardwareBuffer::HBL_NORMAL);
+                destNormData = lockBuffer(destNormBuf.get(), destNormBuf->getVertexSize() == destElemNorm->getSize()
+                                                                 ? HardwareBuffer::HBL_DISCARD
+                                                                 : HardwareBuffer::HBL_NORMAL);
             }
-            destElemNorm->baseVertexPointerToElement(destNormLock.pData ? destNormLock.pData : destPosLock.pData, &pDestNorm);
-        }
-
-        auto srcPosStride = srcPosBuf->getVertexSize();
-        auto destPosStride = destPosBuf->getVertexSize();
-        auto blendIdxStride = srcIdxBuf->getVertexSize();
-        auto blendWeightStride = srcWeightBuf->getVertexSize();
-
+            destElemNorm->baseVertexPointerToElement(destNormData, &pDestNorm);
+        }
+
+        info.srcPos = pSrcPos;
+        info.destPos = pDestPos;
+        info.srcNorm = pSrcNorm;
+        info.destNorm = pDestNorm;
+        info.blendWeight = pBlendWeight;
+        info.blendIndex = pBlendIdx;
+        info.srcPosStride = srcPosBuf->getVertexSize();
+        info.destPosStride = destPosBuf->getVertexSize();
+        info.blendIndexStride = srcIdxBuf->getVertexSize();
+        info.blendWeightStride = srcWeightBuf->getVertexSize();
+        info.numVertices = targetVertexData->vertexCount;
+        return info;
+    }
+    //---------------------------------------------------------------------
+    void Mesh::SoftwareVertexBlendInfo::blend(const Affine3* const* blendMatrices, size_t start,
+                                              size_t count) const
+    {
         OptimisedUtil::getImplementation()->softwareVertexSkinning(
-            pSrcPos, pDestPos,
-            pSrcNorm, pDestNorm,
-            pBlendWeight, pBlendIdx,
+            rawOffsetPointer(srcPos, start * srcPosStride), rawOffsetPointer(destPos, start * destPosStride),
+            srcNorm ? rawOffsetPointer(srcNorm, start * srcNormStride) : NULL,
+            destNorm ? rawOffsetPointer(destNorm, start * destNormStride) : NULL,
+            rawOffsetPointer(blendWeight, start * blendWeightStride),
+            rawOffsetPointer(blendIndex, start * blendIndexStride),
             blendMatrices,
             srcPosStride, destPosStride,
             srcNormStride, destNormStride,
-            blendWeightStride, blendIdxStride,
+            blendWeightStride, blendIndexStride,
             numWeightsPerVertex,
-            targetVertexData->vertexCount);
+            count);
     }
     //---------------------------------------------------------------------
     void Mesh::softwareVertexMorph(float t,
@@ -0,0 +1,314 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#include "OgreStableHeaders.h"
+#include "OgreNodeTransformStore.h"
+
+namespace Ogre
+{
+    /// number of consecutive nodes processed by one thread
+    static const size_t NODES_PER_TASK = 256;
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::Vector3Block::resize(size_t n)
+    {
+        x.resize(n);
+        y.resize(n);
+        z.resize(n);
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::QuaternionBlock::resize(size_t n)
+    {
+        w.resize(n);
+        x.resize(n);
+        y.resize(n);
+        z.resize(n);
+    }
+    //-----------------------------------------------------------------------
+    NodeTransformStore::NodeTransformStore() : mLayoutChanged(true) {}
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::build(SceneNode* root)
+    {
+        mNodes.clear();
+        mParents.clear();
+        mLevels.clear();
+
+        mNodes.push_back(root);
+        mParents.push_back(0);
+
+        // breadth first, so every level is a contiguous range
+        size_t levelBegin = 0;
+        while (levelBegin < mNodes.size())
+        {
+            mLevels.push_back(levelBegin);
+            size_t levelEnd = mNodes.size();
+            for (size_t i = levelBegin; i < levelEnd; i++)
+            {
+                for (auto c : mNodes[i]->getChildren())
+                {
+                    mNodes.push_back(static_cast<SceneNode*>(c));
+                    mParents.push_back(uint32(i));
+                }
+            }
+            levelBegin = levelEnd;
+        }
+        mLevels.push_back(mNodes.size());
+
+        size_t n = mNodes.size();
+        mFlags.resize(n);
+        mPosition.resize(n);
+        mOrientation.resize(n);
+        mScale.resize(n);
+        mDerivedPosition.resize(n);
+        mDerivedOrientation.resize(n);
+        mDerivedScale.resize(n);
+        for (auto& row : mWorldTransform)
+            row.resize(n);
+
+        mLayoutChanged = false;
+    }
+    //-----------------------------------------------------------------------
+    Affine3 NodeTransformStore::getWorldTransform(size_t i) const
+    {
+        const auto& m = mWorldTransform;
+        return Affine3(m[0][i], m[1][i], m[2][i], m[3][i],
+                       m[4][i], m[5][i], m[6][i], m[7][i],
+                       m[8][i], m[9][i], m[10][i], m[11][i]);
+    }
+    //-----------------------------------------------------------------------
+    template <typename F> void NodeTransformStore::forEachLevel(WorkQueue* queue, bool reverse, const F& func)
+    {
+        size_t numLevels = mLevels.size() - 1;
+        for (size_t l = 0; l < numLevels; l++)
+        {
+            size_t level = reverse ? numLevels - 1 - l : l;
+            size_t begin = mLevels[level];
+            size_t end = mLevels[level + 1];
+
+            if (!queue || end - begin < 2 * NODES_PER_TASK)
+            {
+                func(begin, end);
+                continue;
+            }
+
+            size_t numTasks = (end - begin + NODES_PER_TASK - 1) / NODES_PER_TASK;
+            queue->parallelFor(0, numTasks, [begin, end, &func](size_t t) {
+                size_t first = begin + t * NODES_PER_TASK;
+                func(first, std::min(first + NODES_PER_TASK, end));
+            });
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::gather(size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            SceneNode* node = mNodes[i];
+
+            uint8 flags = 0;
+            if (node->mInheritOrientation)
+                flags |= INHERIT_ORIENTATION;
+            if (node->mInheritScale)
+                flags |= INHERIT_SCALE;
+
+            if (i == 0)
+            {
+                // the root might have a parent outside of the store, so use the regular path
+                if (node->mNeedParentUpdate)
+                {
+                    node->_updateFromParent();
+                    flags |= NEEDS_UPDATE;
+                }
+            }
+            else
+            {
+                uint32 p = mParents[i];
+                if (node->mNeedParentUpdate || (mFlags[p] & NEEDS_UPDATE) || mNodes[p]->mNeedChildUpdate)
+                    flags |= NEEDS_UPDATE;
+            }
+            mFlags[i] = flags;
+
+            if ((flags & NEEDS_UPDATE) && i != 0)
+            {
+                mPosition.x[i] = node->mPosition.x;
+                mPosition.y[i] = node->mPosition.y;
+                mPosition.z[i] = node->mPosition.z;
+                mOrientation.w[i] = node->mOrientation.w;
+                mOrientation.x[i] = node->mOrientation.x;
+                mOrientation.y[i] = node->mOrientation.y;
+                mOrientation.z[i] = node->mOrientation.z;
+                mScale.x[i] = node->mScale.x;
+                mScale.y[i] = node->mScale.y;
+                mScale.z[i] = node->mScale.z;
+            }
+            else
+            {
+                // up to date, just provide the values for the children
+                mDerivedPosition.x[i] = node->mDerivedPosition.x;
+                mDerivedPosition.y[i] = node->mDerivedPosition.y;
+                mDerivedPosition.z[i] = node->mDerivedPosition.z;
+                mDerivedOrientation.w[i] = node->mDerivedOrientation.w;
+                mDerivedOrientation.x[i] = node->mDerivedOrientation.x;
+                mDerivedOrientation.y[i] = node->mDerivedOrientation.y;
+                mDerivedOrientation.z[i] = node->mDerivedOrientation.z;
+                mDerivedScale.x[i] = node->mDerivedScale.x;
+                mDerivedScale.y[i] = node->mDerivedScale.y;
+                mDerivedScale.z[i] = node->mDerivedScale.z;
+            }
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::combine(size_t begin, size_t end)
+    {
+        // same operations in the same order as Node::updateFromParentImpl and
+        // Affine3::makeTransform, so the results are identical to the regular update
+        const uint32* parents = mParents.data();
+        const uint8* flags = mFlags.data();
+
+        Real* dpx = mDerivedPosition.x.data();
+        Real* dpy = mDerivedPosition.y.data();
+        Real* dpz = mDerivedPosition.z.data();
+        Real* dqw = mDerivedOrientation.w.data();
+        Real* dqx = mDerivedOrientation.x.data();
+        Real* dqy = mDerivedOrientation.y.data();
+        Real* dqz = mDerivedOrientation.z.data();
+        Real* dsx = mDerivedScale.x.data();
+        Real* dsy = mDerivedScale.y.data();
+        Real* dsz = mDerivedScale.z.data();
+
+        for (size_t i = std::max<size_t>(begin, 1); i < end; i++)
+        {
+            if (!(flags[i] & NEEDS_UPDATE))
+                continue;
+
+            uint32 p = parents[i];
+            Real pqw = dqw[p], pqx = dqx[p], pqy = dqy[p], pqz = dqz[p];
+            Real psx = dsx[p], psy = dsy[p], psz = dsz[p];
+
+            Real qw = mOrientation.w[i], qx = mOrientation.x[i], qy = mOrientation.y[i], qz = mOrientation.z[i];
+            if (flags[i] & INHERIT_ORIENTATION)
+            {
+                dqw[i] = pqw * qw - pqx * qx - pqy * qy - pqz * qz;
+                dqx[i] = pqw * qx + pqx * qw + pqy * qz - pqz * qy;
+                dqy[i] = pqw * qy + pqy * qw + pqz * qx - pqx * qz;
+                dqz[i] = pqw * qz + pqz * qw + pqx * qy - pqy * qx;
+            }
+            else
+            {
+                dqw[i] = qw;
+                dqx[i] = qx;
+                dqy[i] = qy;
+                dqz[i] = qz;
+            }
+
+            if (flags[i] & INHERIT_SCALE)
+            {
+                dsx[i] = psx * mScale.x[i];
+                dsy[i] = psy * mScale.y[i];
+                dsz[i] = psz * mScale.z[i];
+            }
+            else
+            {
+                dsx[i] = mScale.x[i];
+                dsy[i] = mScale.y[i];
+                dsz[i] = mScale.z[i];
+            }
+
+            // rotate the scaled position by the parent orientation
+            Real vx = psx * mPosition.x[i], vy = psy * mPosition.y[i], vz = psz * mPosition.z[i];
+            Real uvx = pqy * vz - pqz * vy, uvy = pqz * vx - pqx * vz, uvz = pqx * vy - pqy * vx;
+            Real uuvx = pqy * uvz - pqz * uvy, uuvy = pqz * uvx - pqx * uvz, uuvz = pqx * uvy - pqy * uvx;
+            Real w2 = 2.0f * pqw;
+            dpx[i] = vx + uvx * w2 + uuvx * 2.0f + dpx[p];
+            dpy[i] = vy + uvy * w2 + uuvy * 2.0f + dpy[p];
+            dpz[i] = vz + uvz * w2 + uuvz * 2.0f + dpz[p];
+        }
+
+        Real* m[12];
+        for (int r = 0; r < 12; r++)
+            m[r] = mWorldTransform[r].data();
+
+        for (size_t i = begin; i < end; i++)
+        {
+            Real tx = dqx[i] + dqx[i], ty = dqy[i] + dqy[i], tz = dqz[i] + dqz[i];
+            Real twx = tx * dqw[i], twy = ty * dqw[i], twz = tz * dqw[i];
+            Real txx = tx * dqx[i], txy = ty * dqx[i], txz = tz * dqx[i];
+            Real tyy = ty * dqy[i], tyz = tz * dqy[i], tzz = tz * dqz[i];
+
+            m[0][i] = dsx[i] * (1.0f - (tyy + tzz));
+            m[1][i] = dsy[i] * (txy - twz);
+            m[2][i] = dsz[i] * (txz + twy);
+            m[3][i] = dpx[i];
+            m[4][i] = dsx[i] * (txy + twz);
+            m[5][i] = dsy[i] * (1.0f - (txx + tzz));
+            m[6][i] = dsz[i] * (tyz - twx);
+            m[7][i] = dpy[i];
+            m[8][i] = dsx[i] * (txz - twy);
+            m[9][i] = dsy[i] * (tyz + twx);
+            m[10][i] = dsz[i] * (1.0f - (txx + tyy));
+            m[11][i] = dpz[i];
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::scatter(size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            if (!(mFlags[i] & (NEEDS_UPDATE | BOUNDS_CHANGED)))
+                continue;
+
+            SceneNode* node = mNodes[i];
+            node->mParentNotified = false;
+            node->mNeedChildUpdate = false;
+            node->mChildrenToUpdate.clear();
+
+            if (!(mFlags[i] & NEEDS_UPDATE) || i == 0)
+                continue;
+
+            node->mDerivedPosition = Vector3(mDerivedPosition.x[i], mDerivedPosition.y[i], mDerivedPosition.z[i]);
+            node->mDerivedOrientation = Quaternion(mDerivedOrientation.w[i], mDerivedOrientation.x[i],
+                                                   mDerivedOrientation.y[i], mDerivedOrientation.z[i]);
+            node->mDerivedScale = Vector3(mDerivedScale.x[i], mDerivedScale.y[i], mDerivedScale.z[i]);
+            node->mCachedTransform = getWorldTransform(i);
+            node->mCachedTransformOutOfDate = false;
+            node->mNeedParentUpdate = false;
+
+            // same notifications as SceneNode::_updateFromParent
+            for (auto o : node->getAttachedObjects())
+                o->_notifyMoved();
+
+            if (auto listener = node->getListener())
+                listener->nodeUpdated(node);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void NodeTransformStore::update(WorkQueue* queue)
+    {
+        if (mNodes.empty())
+            return;
+#if OGRE_NODE_INHERIT_TRANSFORM
+        // full matrices are inherited, which the store does not support
+        mNodes[0]->_update(true, false);
+#else
+        forEachLevel(queue, false, [this](size_t begin, size_t end) { gather(begin, end); });
+
+        // ancestors of updated nodes need their bounds merged again
+        for (size_t i = mNodes.size() - 1; i > 0; i--)
+        {
+            if (mFlags[i] & (NEEDS_UPDATE | BOUNDS_CHANGED))
+                mFlags[mParents[i]] |= BOUNDS_CHANGED;
+        }
+
+        forEachLevel(queue, false, [this](size_t begin, size_t end) { combine(begin, end); });
+        forEachLevel(queue, false, [this](size_t begin, size_t end) { scatter(begin, end); });
+        forEachLevel(queue, true, [this](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                if (mFlags[i] & (NEEDS_UPDATE | BOUNDS_CHANGED))
+                    mNodes[i]->_updateBounds();
+            }
+        });
+#endif
+    }
+} // namespace Ogre
@@ -0,0 +1,114 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#ifndef __NodeTransformStore_H__
+#define __NodeTransformStore_H__
+
+#include "OgrePrerequisites.h"
+
+namespace Ogre
+{
+/** \addtogroup Core
+ *  @{
+ */
+/** \addtogroup Scene
+ *  @{
+ */
+/** Flat, data oriented storage of the derived transforms of a SceneNode hierarchy
+
+    The nodes are laid out breadth first, i.e. ordered by their depth in the hierarchy, so
+    every parent is stored before its children. The derived orientation, position, scale and
+    the 3x4 world matrix are kept as structure-of-arrays, which turns the recursive
+    Node::_update into linear passes over contiguous memory:
+
+    1. gather the local transforms of the nodes that need an update
+    2. combine them with the parent transforms, one depth level at a time
+    3. write the results back to the nodes and notify the attached objects
+    4. merge the world bounds bottom-up
+
+    The nodes keep their API and their cached derived state, so code reading e.g.
+    Node::_getDerivedPosition is not affected. The layout must be rebuilt after the hierarchy
+    changed, which SceneManager does automatically.
+    @note Node subclasses which override Node::_update or Node::updateFromParentImpl are not
+    supported, as those hooks are bypassed.
+*/
+class NodeTransformStore : public NodeAlloc
+{
+public:
+    NodeTransformStore();
+
+    /// Lay out the hierarchy below root (inclusive), clears the layout changed flag
+    void build(SceneNode* root);
+
+    /** Update the derived transforms and world bounds of all nodes which need it
+
+        This gives the same results as calling root->_update(true, false).
+        @param queue if not NULL, the depth levels are processed in parallel by the workers
+    */
+    void update(WorkQueue* queue = NULL);
+
+    /// Notify the store that nodes were added or removed from the hierarchy
+    void _notifyLayoutChanged() { mLayoutChanged = true; }
+    /// Whether build() must be called before the next update()
+    bool isLayoutChanged() const { return mLayoutChanged; }
+
+    /// Number of nodes in the store
+    size_t getNodeCount() const { return mNodes.size(); }
+    /// The nodes, ordered by depth
+    const std::vector<SceneNode*>& getNodes() const { return mNodes; }
+    /// The world matrix of the node at the given index, as of the last update
+    Affine3 getWorldTransform(size_t index) const;
+
+private:
+    enum Flags
+    {
+        NEEDS_UPDATE = 1,
+        BOUNDS_CHANGED = 2,
+        INHERIT_ORIENTATION = 4,
+        INHERIT_SCALE = 8
+    };
+
+    struct Vector3Block
+    {
+        std::vector<Real> x, y, z;
+        void resize(size_t n);
+    };
+    struct QuaternionBlock
+    {
+        std::vector<Real> w, x, y, z;
+        void resize(size_t n);
+    };
+
+    void gather(size_t begin, size_t end);
+    void combine(size_t begin, size_t end);
+    void scatter(size_t begin, size_t end);
+
+    /// Calls func for every depth level, in order. Ranges within a level may run in parallel.
+    template <typename F> void forEachLevel(WorkQueue* queue, bool reverse, const F& func);
+
+    std::vector<SceneNode*> mNodes;
+    /// index of the parent node; the root refers to itself
+    std::vector<uint32> mParents;
+    /// first node index of every depth level plus the total node count
+    std::vector<size_t> mLevels;
+    std::vector<uint8> mFlags;
+
+    Vector3Block mPosition;
+    QuaternionBlock mOrientation;
+    Vector3Block mScale;
+
+    Vector3Block mDerivedPosition;
+    QuaternionBlock mDerivedOrientation;
+    Vector3Block mDerivedScale;
+    /// rows of the 3x4 world matrix
+    std::vector<Real> mWorldTransform[12];
+
+    bool mLayoutChanged;
+};
+/** @} */
+/** @} */
+} // namespace Ogre
+
+#endif
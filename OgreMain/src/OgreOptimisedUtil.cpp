@@ -38,6 +38,16 @@ namespace Ogre {
 #if __OGRE_HAVE_SSE || __OGRE_HAVE_NEON
     extern OptimisedUtil* _getOptimisedUtilSSE(void);
 #endif
+#if __OGRE_HAVE_AVX2
+    extern OptimisedUtil* _getOptimisedUtilAVX2(void);
+
+    //---------------------------------------------------------------------
+    static bool _isAVX2Supported(void)
+    {
+        const uint required = PlatformInformation::CPU_FEATURE_AVX2 | PlatformInformation::CPU_FEATURE_FMA;
+        return (PlatformInformation::getCpuFeatures() & required) == required;
+    }
+#endif
 
 #ifdef __DO_PROFILE__
     //---------------------------------------------------------------------
@@ -50,6 +60,9 @@ namespace Ogre {
             IMPL_DEFAULT,
 #if __OGRE_HAVE_SSE || __OGRE_HAVE_NEON
             IMPL_SSE,
+#endif
+#if __OGRE_HAVE_AVX2
+            IMPL_AVX2,
 #endif
             IMPL_COUNT
         };
@@ -97,6 +110,12 @@ namespace Ogre {
             {
                 mOptimisedUtils.push_back(_getOptimisedUtilSSE());
             }
+#endif
+#if __OGRE_HAVE_AVX2
+            if (_isAVX2Supported())
+            {
+                mOptimisedUtils.push_back(_getOptimisedUtilAVX2());
+            }
 #endif
         }
 
@@ -368,6 +387,13 @@ namespace Ogre {
 
 #else   // !__DO_PROFILE__
 
+#if __OGRE_HAVE_AVX2
+        if (_isAVX2Supported())
+        {
+            return _getOptimisedUtilAVX2();
+        }
+        else
+#endif  // __OGRE_HAVE_AVX2
 #if __OGRE_HAVE_SSE
         if (PlatformInformation::getCpuFeatures() & PlatformInformation::CPU_FEATURE_SSE)
         {
@@ -387,5 +413,23 @@ namespace Ogre {
 
 #endif  // __DO_PROFILE__
     }
+    //---------------------------------------------------------------------
+    OptimisedUtil* OptimisedUtil::_getImplementation(const String& isa)
+    {
+        if (isa == "General")
+            return _getOptimisedUtilGeneral();
+#if __OGRE_HAVE_SSE
+        if (isa == "SSE" && PlatformInformation::hasCpuFeature(PlatformInformation::CPU_FEATURE_SSE))
+            return _getOptimisedUtilSSE();
+#elif __OGRE_HAVE_NEON
+        if (isa == "SSE" && PlatformInformation::hasCpuFeature(PlatformInformation::CPU_FEATURE_NEON))
+            return _getOptimisedUtilSSE();
+#endif
+#if __OGRE_HAVE_AVX2
+        if (isa == "AVX2" && _isAVX2Supported())
+            return _getOptimisedUtilAVX2();
+#endif
+        return NULL;
+    }
 
 }
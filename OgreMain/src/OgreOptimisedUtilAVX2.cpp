@@ -0,0 +1,630 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#include "OgreStableHeaders.h"
+#include "OgreOptimisedUtil.h"
+
+#if __OGRE_HAVE_AVX2
+
+#include <immintrin.h>
+
+// The rest of OgreMain is built for the baseline instruction set, so AVX2 and FMA are only
+// enabled for the functions below, which are only called after checking the CPU supports them.
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+#   define OGRE_AVX2_TARGET
+#else
+#   define OGRE_AVX2_TARGET __attribute__((target("avx2,fma")))
+#endif
+
+namespace Ogre {
+
+//-------------------------------------------------------------------------
+// Local classes
+//-------------------------------------------------------------------------
+
+    /** AVX2 and FMA implementation of OptimisedUtil.
+
+        Where the data layout allows it, 8 vertices, triangles or faces are processed at once, with
+        the positions deinterleaved into x, y and z registers. Otherwise the 256 bit registers hold
+        two matrix rows.
+    @note
+        Don't use this class directly, use OptimisedUtil instead.
+    */
+    class _OgrePrivate OptimisedUtilAVX2 : public OptimisedUtil
+    {
+    public:
+        /// @copydoc OptimisedUtil::softwareVertexSkinning
+        void softwareVertexSkinning(
+            const float *srcPosPtr, float *destPosPtr,
+            const float *srcNormPtr, float *destNormPtr,
+            const float *blendWeightPtr, const unsigned char* blendIndexPtr,
+            const Affine3* const* blendMatrices,
+            size_t srcPosStride, size_t destPosStride,
+            size_t srcNormStride, size_t destNormStride,
+            size_t blendWeightStride, size_t blendIndexStride,
+            size_t numWeightsPerVertex,
+            size_t numVertices) override;
+
+        /// @copydoc OptimisedUtil::softwareVertexMorph
+        void softwareVertexMorph(
+            float t,
+            const float *srcPos1, const float *srcPos2,
+            float *dstPos,
+            size_t pos1VSize, size_t pos2VSize, size_t dstVSize,
+            size_t numVertices,
+            bool morphNormals) override;
+
+        /// @copydoc OptimisedUtil::concatenateAffineMatrices
+        void concatenateAffineMatrices(
+            const Affine3& baseMatrix,
+            const Affine3* srcMatrices,
+            Affine3* dstMatrices,
+            size_t numMatrices) override;
+
+        /// @copydoc OptimisedUtil::calculateFaceNormals
+        void calculateFaceNormals(
+            const float *positions,
+            const EdgeData::Triangle *triangles,
+            Vector4 *faceNormals,
+            size_t numTriangles) override;
+
+        /// @copydoc OptimisedUtil::calculateLightFacing
+        void calculateLightFacing(
+            const Vector4& lightPos,
+            const Vector4* faceNormals,
+            char* lightFacings,
+            size_t numFaces) override;
+
+        /// @copydoc OptimisedUtil::extrudeVertices
+        void extrudeVertices(
+            const Vector4& lightPos,
+            Real extrudeDist,
+            const float* srcPositions,
+            float* destPositions,
+            size_t numVertices) override;
+    };
+
+//-------------------------------------------------------------------------
+// Helpers
+//-------------------------------------------------------------------------
+
+    /// load (x, y, z, 0) without reading past the vector
+    static inline OGRE_AVX2_TARGET __m128 _load3(const float* p)
+    {
+        __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p)));
+        return _mm_insert_ps(xy, _mm_load_ss(p + 2), 0x20);
+    }
+
+    static inline OGRE_AVX2_TARGET void _store3(float* p, __m128 v)
+    {
+        _mm_store_sd(reinterpret_cast<double*>(p), _mm_castps_pd(v));
+        _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+    }
+
+    /// normalise the xyz part, leaving zero vectors unchanged like Vector3::normalise
+    static inline OGRE_AVX2_TARGET __m128 _normalise3(__m128 v)
+    {
+        __m128 len = _mm_sqrt_ps(_mm_dp_ps(v, v, 0x7F));
+        __m128 mask = _mm_cmpgt_ps(len, _mm_setzero_ps());
+        return _mm_blendv_ps(v, _mm_div_ps(v, len), mask);
+    }
+
+    /// the (x, y, z) of the 2 rows in m times v, with the third row in m2
+    static inline OGRE_AVX2_TARGET __m128 _transform3x4(__m256 m01, __m128 m2, __m128 v)
+    {
+        __m256 p01 = _mm256_mul_ps(m01, _mm256_insertf128_ps(_mm256_castps128_ps256(v), v, 1));
+        __m128 p2 = _mm_mul_ps(m2, v);
+        __m128 h01 = _mm_hadd_ps(_mm256_castps256_ps128(p01), _mm256_extractf128_ps(p01, 1));
+        return _mm_hadd_ps(h01, _mm_hadd_ps(p2, p2));
+    }
+
+    // Blend masks and permutations to convert 8 packed xyz vectors, loaded to
+    // a = (x0 y0 z0 x1 y1 z1 x2 y2), b = (z2 x3 y3 z3 x4 y4 z4 x5), c = (y5 z5 x6 y6 z6 x7 y7 z7)
+    // from and to x, y and z registers. Every register of the blended a, b and c holds one of the
+    // components of all vertices, in the lanes given by the permutations.
+    enum
+    {
+        LANES_036 = 0x49,
+        LANES_147 = 0x92,
+        LANES_25 = 0x24
+    };
+
+    static inline OGRE_AVX2_TARGET void _deinterleave8(__m256 a, __m256 b, __m256 c, __m256& x, __m256& y, __m256& z)
+    {
+        __m256 bx = _mm256_blend_ps(_mm256_blend_ps(a, b, LANES_147), c, LANES_25);
+        __m256 by = _mm256_blend_ps(_mm256_blend_ps(a, b, LANES_25), c, LANES_036);
+        __m256 bz = _mm256_blend_ps(_mm256_blend_ps(a, b, LANES_036), c, LANES_147);
+        x = _mm256_permutevar8x32_ps(bx, _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5));
+        y = _mm256_permutevar8x32_ps(by, _mm256_setr_epi32(1, 4, 7, 2, 5, 0, 3, 6));
+        z = _mm256_permutevar8x32_ps(bz, _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7));
+    }
+
+    static inline OGRE_AVX2_TARGET void _interleave8(float* p, __m256 x, __m256 y, __m256 z)
+    {
+        __m256 bx = _mm256_permutevar8x32_ps(x, _mm256_setr_epi32(0, 3, 6, 1, 4, 7, 2, 5));
+        __m256 by = _mm256_permutevar8x32_ps(y, _mm256_setr_epi32(5, 0, 3, 6, 1, 4, 7, 2));
+        __m256 bz = _mm256_permutevar8x32_ps(z, _mm256_setr_epi32(2, 5, 0, 3, 6, 1, 4, 7));
+        _mm256_storeu_ps(p, _mm256_blend_ps(_mm256_blend_ps(bx, by, LANES_147), bz, LANES_25));
+        _mm256_storeu_ps(p + 8, _mm256_blend_ps(_mm256_blend_ps(bx, by, LANES_25), bz, LANES_036));
+        _mm256_storeu_ps(p + 16, _mm256_blend_ps(_mm256_blend_ps(bx, by, LANES_036), bz, LANES_147));
+    }
+
+    /// scale factors normalising the vectors of the given lengths, zero vectors stay unchanged
+    static inline OGRE_AVX2_TARGET __m256 _invLength8(__m256 squaredLength)
+    {
+        __m256 len = _mm256_sqrt_ps(squaredLength);
+        __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), len);
+        return _mm256_and_ps(inv, _mm256_cmp_ps(len, _mm256_setzero_ps(), _CMP_GT_OQ));
+    }
+
+    /// load the (x, y, z) of 8 vectors to separate registers, with the given stride in bytes
+    static inline OGRE_AVX2_TARGET void _load8(const float* p, size_t stride, __m256& x, __m256& y, __m256& z)
+    {
+        // transpose the 4x4 blocks of the vectors 0 and 4, 1 and 5...
+        __m256 v[4];
+        for (int i = 0; i < 4; ++i)
+            v[i] = _mm256_insertf128_ps(_mm256_castps128_ps256(_load3(rawOffsetPointer(p, i * stride))),
+                                        _load3(rawOffsetPointer(p, (i + 4) * stride)), 1);
+        __m256 a = _mm256_unpacklo_ps(v[0], v[1]), b = _mm256_unpackhi_ps(v[0], v[1]);
+        __m256 c = _mm256_unpacklo_ps(v[2], v[3]), d = _mm256_unpackhi_ps(v[2], v[3]);
+        x = _mm256_shuffle_ps(a, c, 0x44);
+        y = _mm256_shuffle_ps(a, c, 0xEE);
+        z = _mm256_shuffle_ps(b, d, 0x44);
+    }
+
+    /// store the (x, y, z) of 8 vectors from separate registers with the given stride in bytes
+    static inline OGRE_AVX2_TARGET void _scatter8(float* p, size_t stride, __m256 x, __m256 y, __m256 z)
+    {
+        // transpose the 4x4 blocks, giving the vectors 0 and 4, 1 and 5...
+        __m256 a = _mm256_unpacklo_ps(x, y), b = _mm256_unpackhi_ps(x, y);
+        __m256 c = _mm256_unpacklo_ps(z, z), d = _mm256_unpackhi_ps(z, z);
+        __m256 v[4] = {_mm256_shuffle_ps(a, c, 0x44), _mm256_shuffle_ps(a, c, 0xEE),
+                       _mm256_shuffle_ps(b, d, 0x44), _mm256_shuffle_ps(b, d, 0xEE)};
+        for (int i = 0; i < 4; ++i)
+        {
+            _store3(rawOffsetPointer(p, i * stride), _mm256_castps256_ps128(v[i]));
+            _store3(rawOffsetPointer(p, (i + 4) * stride), _mm256_extractf128_ps(v[i], 1));
+        }
+    }
+
+    /// the weighted sum of the blend matrices of a vertex, rows 0 and 1 in m01 and row 2 in m2
+    static inline OGRE_AVX2_TARGET void _blendMatrices(const float* pBlendWeight, const unsigned char* pBlendIndex,
+                                                       const Affine3* const* blendMatrices,
+                                                       size_t numWeightsPerVertex, __m256& m01, __m128& m2)
+    {
+        // row 3 is always (0, 0, 0, 1) and not needed
+        m01 = _mm256_setzero_ps();
+        m2 = _mm_setzero_ps();
+        for (size_t blendIdx = 0; blendIdx < numWeightsPerVertex; ++blendIdx)
+        {
+            const Affine3& mat = *blendMatrices[pBlendIndex[blendIdx]];
+            __m256 weight = _mm256_set1_ps(pBlendWeight[blendIdx]);
+            m01 = _mm256_fmadd_ps(weight, _mm256_loadu_ps(mat[0]), m01);
+            m2 = _mm_fmadd_ps(_mm256_castps256_ps128(weight), _mm_load_ps(mat[2]), m2);
+        }
+    }
+
+    /** transpose the blended matrices of 8 vertices, so m[i] holds the element i of all of them,
+        counting row by row */
+    static inline OGRE_AVX2_TARGET void _transposeMatrices(const __m256* m01, const __m128* m2, __m256* m)
+    {
+        // rows 0 and 1 are a 8x8 transpose
+        __m256 t[8], u[8];
+        for (int i = 0; i < 8; i += 2)
+        {
+            t[i] = _mm256_unpacklo_ps(m01[i], m01[i + 1]);
+            t[i + 1] = _mm256_unpackhi_ps(m01[i], m01[i + 1]);
+        }
+        for (int i = 0; i < 8; i += 4)
+        {
+            u[i] = _mm256_shuffle_ps(t[i], t[i + 2], 0x44);
+            u[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], 0xEE);
+            u[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0x44);
+            u[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0xEE);
+        }
+        for (int i = 0; i < 4; ++i)
+        {
+            m[i] = _mm256_permute2f128_ps(u[i], u[i + 4], 0x20);
+            m[i + 4] = _mm256_permute2f128_ps(u[i], u[i + 4], 0x31);
+        }
+
+        // row 2 is a 4x4 transpose of the vertices 0 to 3 and 4 to 7 at once
+        __m256 r[4];
+        for (int i = 0; i < 4; ++i)
+            r[i] = _mm256_insertf128_ps(_mm256_castps128_ps256(m2[i]), m2[i + 4], 1);
+        __m256 a = _mm256_unpacklo_ps(r[0], r[1]), b = _mm256_unpackhi_ps(r[0], r[1]);
+        __m256 c = _mm256_unpacklo_ps(r[2], r[3]), d = _mm256_unpackhi_ps(r[2], r[3]);
+        m[8] = _mm256_shuffle_ps(a, c, 0x44);
+        m[9] = _mm256_shuffle_ps(a, c, 0xEE);
+        m[10] = _mm256_shuffle_ps(b, d, 0x44);
+        m[11] = _mm256_shuffle_ps(b, d, 0xEE);
+    }
+
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    OGRE_AVX2_TARGET void OptimisedUtilAVX2::softwareVertexSkinning(
+        const float *pSrcPos, float *pDestPos,
+        const float *pSrcNorm, float *pDestNorm,
+        const float *pBlendWeight, const unsigned char* pBlendIndex,
+        const Affine3* const* blendMatrices,
+        size_t srcPosStride, size_t destPosStride,
+        size_t srcNormStride, size_t destNormStride,
+        size_t blendWeightStride, size_t blendIndexStride,
+        size_t numWeightsPerVertex,
+        size_t numVertices)
+    {
+        // 8 vertices at a time: the matrices blended per vertex are transposed, so the vertices are
+        // transformed with their x, y and z components in separate registers
+        for (; numVertices >= 8; numVertices -= 8)
+        {
+            __m256 m01[8], m[12];
+            __m128 m2[8];
+            for (int i = 0; i < 8; ++i)
+            {
+                _blendMatrices(pBlendWeight, pBlendIndex, blendMatrices, numWeightsPerVertex, m01[i], m2[i]);
+                advanceRawPointer(pBlendWeight, blendWeightStride);
+                advanceRawPointer(pBlendIndex, blendIndexStride);
+            }
+            _transposeMatrices(m01, m2, m);
+
+            __m256 x, y, z;
+            _load8(pSrcPos, srcPosStride, x, y, z);
+            _scatter8(pDestPos, destPosStride,
+                      _mm256_fmadd_ps(m[0], x, _mm256_fmadd_ps(m[1], y, _mm256_fmadd_ps(m[2], z, m[3]))),
+                      _mm256_fmadd_ps(m[4], x, _mm256_fmadd_ps(m[5], y, _mm256_fmadd_ps(m[6], z, m[7]))),
+                      _mm256_fmadd_ps(m[8], x, _mm256_fmadd_ps(m[9], y, _mm256_fmadd_ps(m[10], z, m[11]))));
+            advanceRawPointer(pSrcPos, srcPosStride * 8);
+            advanceRawPointer(pDestPos, destPosStride * 8);
+
+            if (pSrcNorm)
+            {
+                // the 3x3 part is assumed to be orthogonal, see OptimisedUtilGeneral
+                _load8(pSrcNorm, srcNormStride, x, y, z);
+                __m256 nx = _mm256_fmadd_ps(m[0], x, _mm256_fmadd_ps(m[1], y, _mm256_mul_ps(m[2], z)));
+                __m256 ny = _mm256_fmadd_ps(m[4], x, _mm256_fmadd_ps(m[5], y, _mm256_mul_ps(m[6], z)));
+                __m256 nz = _mm256_fmadd_ps(m[8], x, _mm256_fmadd_ps(m[9], y, _mm256_mul_ps(m[10], z)));
+                __m256 inv = _invLength8(_mm256_fmadd_ps(nz, nz, _mm256_fmadd_ps(ny, ny, _mm256_mul_ps(nx, nx))));
+                _scatter8(pDestNorm, destNormStride, _mm256_mul_ps(nx, inv), _mm256_mul_ps(ny, inv),
+                          _mm256_mul_ps(nz, inv));
+                advanceRawPointer(pSrcNorm, srcNormStride * 8);
+                advanceRawPointer(pDestNorm, destNormStride * 8);
+            }
+        }
+
+        // the remaining vertices one by one
+        const __m128 one = _mm_setr_ps(0, 0, 0, 1);
+        for (; numVertices; --numVertices)
+        {
+            __m256 m01;
+            __m128 m2;
+            _blendMatrices(pBlendWeight, pBlendIndex, blendMatrices, numWeightsPerVertex, m01, m2);
+
+            __m128 pos = _mm_or_ps(_load3(pSrcPos), one);
+            _store3(pDestPos, _transform3x4(m01, m2, pos));
+
+            if (pSrcNorm)
+            {
+                __m128 norm = _transform3x4(m01, m2, _load3(pSrcNorm));
+                _store3(pDestNorm, _normalise3(norm));
+
+                advanceRawPointer(pSrcNorm, srcNormStride);
+                advanceRawPointer(pDestNorm, destNormStride);
+            }
+
+            advanceRawPointer(pSrcPos, srcPosStride);
+            advanceRawPointer(pDestPos, destPosStride);
+            advanceRawPointer(pBlendWeight, blendWeightStride);
+            advanceRawPointer(pBlendIndex, blendIndexStride);
+        }
+    }
+    //---------------------------------------------------------------------
+    OGRE_AVX2_TARGET void OptimisedUtilAVX2::concatenateAffineMatrices(
+        const Affine3& baseMatrix,
+        const Affine3* pSrcMat,
+        Affine3* pDstMat,
+        size_t numMatrices)
+    {
+        // The base matrix is the same for all results, so splat its columns once. Rows 0 and 1 of
+        // the result are computed together, as column j of both rows times row j of the source.
+        __m256 col01[3];
+        __m128 col2[3];
+        for (int j = 0; j < 3; ++j)
+        {
+            col01[j] = _mm256_setr_ps(baseMatrix[0][j], baseMatrix[0][j], baseMatrix[0][j], baseMatrix[0][j],
+                                      baseMatrix[1][j], baseMatrix[1][j], baseMatrix[1][j], baseMatrix[1][j]);
+            col2[j] = _mm_set1_ps(baseMatrix[2][j]);
+        }
+        // the translation of the base matrix is multiplied with row 3 of the source, i.e. (0, 0, 0, 1)
+        const __m256 trans01 = _mm256_setr_ps(0, 0, 0, baseMatrix[0][3], 0, 0, 0, baseMatrix[1][3]);
+        const __m128 trans2 = _mm_setr_ps(0, 0, 0, baseMatrix[2][3]);
+        const __m128 row3 = _mm_setr_ps(0, 0, 0, 1);
+
+        for (size_t i = 0; i < numMatrices; ++i)
+        {
+            const Affine3& src = *pSrcMat++;
+            Affine3& dst = *pDstMat++;
+
+            __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(src[0]));
+            __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(src[1]));
+            __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(src[2]));
+
+            __m256 d01 = _mm256_fmadd_ps(col01[2], r2, trans01);
+            d01 = _mm256_fmadd_ps(col01[1], r1, d01);
+            d01 = _mm256_fmadd_ps(col01[0], r0, d01);
+
+            __m128 d2 = _mm_fmadd_ps(col2[2], _mm256_castps256_ps128(r2), trans2);
+            d2 = _mm_fmadd_ps(col2[1], _mm256_castps256_ps128(r1), d2);
+            d2 = _mm_fmadd_ps(col2[0], _mm256_castps256_ps128(r0), d2);
+
+            _mm256_storeu_ps(dst[0], d01);
+            _mm_store_ps(dst[2], d2);
+            _mm_store_ps(dst[3], row3);
+        }
+    }
+    //---------------------------------------------------------------------
+    OGRE_AVX2_TARGET void OptimisedUtilAVX2::softwareVertexMorph(
+        float t,
+        const float *pSrc1, const float *pSrc2,
+        float *pDst,
+        size_t pos1VSize, size_t pos2VSize, size_t dstVSize,
+        size_t numVertices,
+        bool morphNormals)
+    {
+        const size_t packedSize = (morphNormals ? 6 : 3) * sizeof(float);
+        if (!morphNormals && pos1VSize == packedSize && pos2VSize == packedSize && dstVSize == packedSize)
+        {
+            // Packed positions, interpolate 8 floats at a time regardless of the vertex boundaries
+            const __m256 t8 = _mm256_set1_ps(t);
+            size_t numFloats = numVertices * 3;
+            size_t i = 0;
+            for (; i + 8 <= numFloats; i += 8)
+            {
+                __m256 a = _mm256_loadu_ps(pSrc1 + i);
+                __m256 b = _mm256_loadu_ps(pSrc2 + i);
+                _mm256_storeu_ps(pDst + i, _mm256_fmadd_ps(t8, _mm256_sub_ps(b, a), a));
+            }
+            for (; i < numFloats; ++i)
+                pDst[i] = pSrc1[i] + t * (pSrc2[i] - pSrc1[i]);
+            return;
+        }
+
+        if (morphNormals && pos1VSize == packedSize && pos2VSize == packedSize && dstVSize == packedSize)
+        {
+            // Packed positions and normals, 4 vertices are 8 vectors, alternating between position
+            // and normal. Interpolate them all, but only normalise the normals.
+            const __m256 t8 = _mm256_set1_ps(t);
+            const __m256 isNormal = _mm256_castsi256_ps(_mm256_setr_epi32(0, -1, 0, -1, 0, -1, 0, -1));
+            const __m256 one = _mm256_set1_ps(1.0f);
+            for (; numVertices >= 4; numVertices -= 4, pSrc1 += 24, pSrc2 += 24, pDst += 24)
+            {
+                __m256 v[3];
+                for (int i = 0; i < 3; ++i)
+                {
+                    __m256 a = _mm256_loadu_ps(pSrc1 + i * 8);
+                    __m256 b = _mm256_loadu_ps(pSrc2 + i * 8);
+                    v[i] = _mm256_fmadd_ps(t8, _mm256_sub_ps(b, a), a);
+                }
+                __m256 x, y, z;
+                _deinterleave8(v[0], v[1], v[2], x, y, z);
+                __m256 inv = _invLength8(_mm256_fmadd_ps(z, z, _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x))));
+                inv = _mm256_blendv_ps(one, inv, isNormal);
+                _interleave8(pDst, _mm256_mul_ps(x, inv), _mm256_mul_ps(y, inv), _mm256_mul_ps(z, inv));
+            }
+        }
+
+        // Interleaved with other elements and the remaining vertices, the destination is written
+        // only once as it might be a locked hardware buffer
+        const __m128 t4 = _mm_set1_ps(t);
+        for (size_t i = 0; i < numVertices; ++i)
+        {
+            __m128 a = _load3(pSrc1);
+            __m128 b = _load3(pSrc2);
+            _store3(pDst, _mm_fmadd_ps(t4, _mm_sub_ps(b, a), a));
+
+            if (morphNormals)
+            {
+                // normals must be in the same buffer as pos, perform an nlerp
+                a = _load3(pSrc1 + 3);
+                b = _load3(pSrc2 + 3);
+                _store3(pDst + 3, _normalise3(_mm_fmadd_ps(t4, _mm_sub_ps(b, a), a)));
+            }
+
+            advanceRawPointer(pSrc1, pos1VSize);
+            advanceRawPointer(pSrc2, pos2VSize);
+            advanceRawPointer(pDst, dstVSize);
+        }
+    }
+    //---------------------------------------------------------------------
+    OGRE_AVX2_TARGET void OptimisedUtilAVX2::calculateFaceNormals(
+        const float *positions,
+        const EdgeData::Triangle *triangles,
+        Vector4 *faceNormals,
+        size_t numTriangles)
+    {
+        // Gather the vertex indices of 8 triangles and then their positions
+        const int triStride = int(sizeof(EdgeData::Triangle) / sizeof(uint32));
+        const __m256i triOffsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                                      _mm256_set1_epi32(triStride));
+
+        for (; numTriangles >= 8; numTriangles -= 8, triangles += 8, faceNormals += 8)
+        {
+            const int* vertIndex = reinterpret_cast<const int*>(triangles[0].vertIndex);
+            __m256i i1 = _mm256_i32gather_epi32(vertIndex, triOffsets, 4);
+            __m256i i2 = _mm256_i32gather_epi32(vertIndex + 1, triOffsets, 4);
+            __m256i i3 = _mm256_i32gather_epi32(vertIndex + 2, triOffsets, 4);
+            // 3 floats per position
+            i1 = _mm256_add_epi32(_mm256_slli_epi32(i1, 1), i1);
+            i2 = _mm256_add_epi32(_mm256_slli_epi32(i2, 1), i2);
+            i3 = _mm256_add_epi32(_mm256_slli_epi32(i3, 1), i3);
+
+            __m256 x1 = _mm256_i32gather_ps(positions, i1, 4);
+            __m256 y1 = _mm256_i32gather_ps(positions + 1, i1, 4);
+            __m256 z1 = _mm256_i32gather_ps(positions + 2, i1, 4);
+
+            __m256 ax = _mm256_sub_ps(_mm256_i32gather_ps(positions, i2, 4), x1);
+            __m256 ay = _mm256_sub_ps(_mm256_i32gather_ps(positions + 1, i2, 4), y1);
+            __m256 az = _mm256_sub_ps(_mm256_i32gather_ps(positions + 2, i2, 4), z1);
+
+            __m256 bx = _mm256_sub_ps(_mm256_i32gather_ps(positions, i3, 4), x1);
+            __m256 by = _mm256_sub_ps(_mm256_i32gather_ps(positions + 1, i3, 4), y1);
+            __m256 bz = _mm256_sub_ps(_mm256_i32gather_ps(positions + 2, i3, 4), z1);
+
+            // normal = (v2 - v1) x (v3 - v1), d = -(normal . v1)
+            __m256 nx = _mm256_fmsub_ps(ay, bz, _mm256_mul_ps(az, by));
+            __m256 ny = _mm256_fmsub_ps(az, bx, _mm256_mul_ps(ax, bz));
+            __m256 nz = _mm256_fmsub_ps(ax, by, _mm256_mul_ps(ay, bx));
+            __m256 d = _mm256_fmadd_ps(nz, z1, _mm256_fmadd_ps(ny, y1, _mm256_mul_ps(nx, x1)));
+            d = _mm256_xor_ps(d, _mm256_set1_ps(-0.0f));
+
+            // transpose to 8 Vector4
+            __m256 t0 = _mm256_unpacklo_ps(nx, ny);
+            __m256 t1 = _mm256_unpackhi_ps(nx, ny);
+            __m256 t2 = _mm256_unpacklo_ps(nz, d);
+            __m256 t3 = _mm256_unpackhi_ps(nz, d);
+            __m256 v04 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 v15 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            __m256 v26 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            __m256 v37 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+            float* dst = faceNormals[0].ptr();
+            _mm256_storeu_ps(dst, _mm256_permute2f128_ps(v04, v15, 0x20));
+            _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(v26, v37, 0x20));
+            _mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(v04, v15, 0x31));
+            _mm256_storeu_ps(dst + 24, _mm256_permute2f128_ps(v26, v37, 0x31));
+        }
+
+        for (; numTriangles; --numTriangles)
+        {
+            const EdgeData::Triangle& t = *triangles++;
+            const float* p1 = positions + t.vertIndex[0] * 3;
+            const float* p2 = positions + t.vertIndex[1] * 3;
+            const float* p3 = positions + t.vertIndex[2] * 3;
+            *faceNormals++ = Math::calculateFaceNormalWithoutNormalize(Vector3(p1), Vector3(p2), Vector3(p3));
+        }
+    }
+    //---------------------------------------------------------------------
+    OGRE_AVX2_TARGET void OptimisedUtilAVX2::calculateLightFacing(
+        const Vector4& lightPos,
+        const Vector4* faceNormals,
+        char* lightFacings,
+        size_t numFaces)
+    {
+        const __m256 light = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lightPos.ptr()));
+        // the horizontal adds below leave the dot products of the faces in this order
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        const __m256i one = _mm256_set1_epi32(1);
+
+        for (; numFaces >= 8; numFaces -= 8, faceNormals += 8, lightFacings += 8)
+        {
+            const float* src = faceNormals[0].ptr();
+            __m256 p01 = _mm256_mul_ps(_mm256_loadu_ps(src), light);
+            __m256 p23 = _mm256_mul_ps(_mm256_loadu_ps(src + 8), light);
+            __m256 p45 = _mm256_mul_ps(_mm256_loadu_ps(src + 16), light);
+            __m256 p67 = _mm256_mul_ps(_mm256_loadu_ps(src + 24), light);
+
+            __m256 dots = _mm256_hadd_ps(_mm256_hadd_ps(p01, p23), _mm256_hadd_ps(p45, p67));
+            dots = _mm256_permutevar8x32_ps(dots, order);
+
+            __m256i facing = _mm256_and_si256(
+                _mm256_castps_si256(_mm256_cmp_ps(dots, _mm256_setzero_ps(), _CMP_GT_OQ)), one);
+            __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(facing), _mm256_extracti128_si256(facing, 1));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(lightFacings), _mm_packus_epi16(words, words));
+        }
+
+        for (; numFaces; --numFaces)
+        {
+            *lightFacings++ = (lightPos.dotProduct(*faceNormals++) > 0);
+        }
+    }
+    //---------------------------------------------------------------------
+    OGRE_AVX2_TARGET void OptimisedUtilAVX2::extrudeVertices(
+        const Vector4& lightPos,
+        Real extrudeDist,
+        const float* pSrcPos,
+        float* pDestPos,
+        size_t numVertices)
+    {
+        if (lightPos.w == 0.0f)
+        {
+            // Directional light, extrusion is along light direction
+            Vector3 dir(-lightPos.x, -lightPos.y, -lightPos.z);
+            dir.normalise();
+            dir *= extrudeDist;
+
+            // 8 packed vertices are 3 registers, each starting with another component
+            const __m256 dirA = _mm256_setr_ps(dir.x, dir.y, dir.z, dir.x, dir.y, dir.z, dir.x, dir.y);
+            const __m256 dirB = _mm256_setr_ps(dir.z, dir.x, dir.y, dir.z, dir.x, dir.y, dir.z, dir.x);
+            const __m256 dirC = _mm256_setr_ps(dir.y, dir.z, dir.x, dir.y, dir.z, dir.x, dir.y, dir.z);
+
+            for (; numVertices >= 8; numVertices -= 8, pSrcPos += 24, pDestPos += 24)
+            {
+                _mm256_storeu_ps(pDestPos, _mm256_add_ps(_mm256_loadu_ps(pSrcPos), dirA));
+                _mm256_storeu_ps(pDestPos + 8, _mm256_add_ps(_mm256_loadu_ps(pSrcPos + 8), dirB));
+                _mm256_storeu_ps(pDestPos + 16, _mm256_add_ps(_mm256_loadu_ps(pSrcPos + 16), dirC));
+            }
+
+            for (; numVertices; --numVertices)
+            {
+                *pDestPos++ = *pSrcPos++ + dir.x;
+                *pDestPos++ = *pSrcPos++ + dir.y;
+                *pDestPos++ = *pSrcPos++ + dir.z;
+            }
+        }
+        else
+        {
+            // Point light, calculate extrusionDir for every vertex
+            assert(lightPos.w == 1.0f);
+
+            const __m256 lx = _mm256_set1_ps(lightPos.x);
+            const __m256 ly = _mm256_set1_ps(lightPos.y);
+            const __m256 lz = _mm256_set1_ps(lightPos.z);
+            const __m256 dist = _mm256_set1_ps(extrudeDist);
+            const __m256 zero = _mm256_setzero_ps();
+
+            for (; numVertices >= 8; numVertices -= 8, pSrcPos += 24, pDestPos += 24)
+            {
+                __m256 x, y, z;
+                _deinterleave8(_mm256_loadu_ps(pSrcPos), _mm256_loadu_ps(pSrcPos + 8), _mm256_loadu_ps(pSrcPos + 16),
+                               x, y, z);
+
+                __m256 dx = _mm256_sub_ps(x, lx);
+                __m256 dy = _mm256_sub_ps(y, ly);
+                __m256 dz = _mm256_sub_ps(z, lz);
+                __m256 len = _mm256_sqrt_ps(
+                    _mm256_fmadd_ps(dz, dz, _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx))));
+
+                // zero length directions stay unchanged, like Vector3::normalise
+                __m256 scale = _mm256_and_ps(_mm256_div_ps(dist, len), _mm256_cmp_ps(len, zero, _CMP_GT_OQ));
+
+                _interleave8(pDestPos, _mm256_fmadd_ps(dx, scale, x), _mm256_fmadd_ps(dy, scale, y),
+                             _mm256_fmadd_ps(dz, scale, z));
+            }
+
+            for (; numVertices; --numVertices)
+            {
+                Vector3 dir(pSrcPos[0] - lightPos.x, pSrcPos[1] - lightPos.y, pSrcPos[2] - lightPos.z);
+                dir.normalise();
+                dir *= extrudeDist;
+
+                *pDestPos++ = *pSrcPos++ + dir.x;
+                *pDestPos++ = *pSrcPos++ + dir.y;
+                *pDestPos++ = *pSrcPos++ + dir.z;
+            }
+        }
+    }
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    //---------------------------------------------------------------------
+    extern OptimisedUtil* _getOptimisedUtilAVX2(void);
+    extern OptimisedUtil* _getOptimisedUtilAVX2(void)
+    {
+        static OptimisedUtilAVX2 msOptimisedUtilAVX2;
+        return &msOptimisedUtilAVX2;
+    }
+
+}
+
+#endif // __OGRE_HAVE_AVX2
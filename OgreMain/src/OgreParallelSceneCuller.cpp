@@ -0,0 +1,159 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#include "OgreStableHeaders.h"
+#include "OgreParallelSceneCuller.h"
+#include "OgreRenderQueueSortingGrouping.h"
+
+namespace Ogre
+{
+    //-----------------------------------------------------------------------
+    ParallelSceneCuller::ParallelSceneCuller() : mCamera(NULL), mOnlyShadowCasters(false) {}
+    //-----------------------------------------------------------------------
+    ParallelSceneCuller::~ParallelSceneCuller() {}
+    //-----------------------------------------------------------------------
+    void ParallelSceneCuller::prepareFragment(Fragment& f, RenderQueue* target)
+    {
+        if (!f.queue)
+            f.queue = std::make_unique<RenderQueue>();
+
+        RenderQueue* q = f.queue.get();
+        q->setDefaultQueueGroup(target->getDefaultQueueGroup());
+        q->setDefaultRenderablePriority(target->getDefaultRenderablePriority());
+        q->setSplitPassesByLightingType(target->getSplitPassesByLightingType());
+        q->setSplitNoShadowPasses(target->getSplitNoShadowPasses());
+        q->setShadowCastersCannotBeReceivers(target->getShadowCastersCannotBeReceivers());
+        q->setSortKeysEnabled(target->getSortKeysEnabled());
+
+        const auto& groups = target->_getQueueGroups();
+        for (uint8 i = 0; i < RENDER_QUEUE_COUNT; i++)
+        {
+            if (!groups[i])
+                continue;
+
+            // the organisation of the target group is not known, so collect for both
+            RenderQueueGroup* g = q->getQueueGroup(i);
+            g->setShadowsEnabled(groups[i]->getShadowsEnabled());
+            g->resetOrganisationModes();
+            g->addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+            g->addOrganisationMode(QueuedRenderableCollection::OM_SORT_DESCENDING);
+        }
+
+        f.bounds.reset();
+        f.nodes.clear();
+    }
+    //-----------------------------------------------------------------------
+    void ParallelSceneCuller::cullObjects(SceneNode* node, Fragment& f)
+    {
+        for (auto o : node->getAttachedObjects())
+            f.queue->processVisibleObject(o, mCamera, mOnlyShadowCasters, &f.bounds);
+
+        f.nodes.push_back(node);
+    }
+    //-----------------------------------------------------------------------
+    void ParallelSceneCuller::cullSubtree(SceneNode* node, Fragment& f)
+    {
+        if (!mCamera->isVisible(node->_getWorldAABB()))
+            return;
+
+        cullObjects(node, f);
+
+        for (auto c : node->getChildren())
+            cullSubtree(static_cast<SceneNode*>(c), f);
+    }
+    //-----------------------------------------------------------------------
+    void ParallelSceneCuller::findVisibleObjects(SceneNode* root, Camera* cam, RenderQueue* queue,
+                                                 VisibleObjectsBoundsInfo* visibleBounds,
+                                                 bool onlyShadowCasters, WorkQueue* workQueue)
+    {
+        mCamera = cam;
+        mOnlyShadowCasters = onlyShadowCasters;
+
+        // the camera updates its view and frustum planes lazily, so do it before the workers
+        // start reading them
+        cam->getViewMatrix(true);
+        if (!cam->isVisible(root->_getWorldAABB()))
+            return;
+
+        size_t numThreads = workQueue->getWorkerThreadCount() + 1;
+        size_t minSubtrees = numThreads * 8;
+
+        // expand the items in place, which keeps the depth first order of the serial traversal
+        mItems.clear();
+        mItems.push_back({root, true});
+        size_t numSubtrees = 1;
+        bool expanded = true;
+        std::vector<WorkItem> next;
+        while (numSubtrees < minSubtrees && expanded)
+        {
+            expanded = false;
+            numSubtrees = 0;
+            next.clear();
+            for (const auto& item : mItems)
+            {
+                if (!item.subtree || item.node->getChildren().empty())
+                {
+                    next.push_back(item);
+                    numSubtrees += item.subtree;
+                    continue;
+                }
+
+                next.push_back({item.node, false});
+                for (auto c : item.node->getChildren())
+                {
+                    SceneNode* child = static_cast<SceneNode*>(c);
+                    if (!cam->isVisible(child->_getWorldAABB()))
+                        continue;
+                    next.push_back({child, true});
+                    numSubtrees++;
+                }
+                expanded = true;
+            }
+            mItems.swap(next);
+        }
+
+        size_t itemsPerFragment = std::max<size_t>(1, mItems.size() / (numThreads * 4));
+        size_t numFragments = (mItems.size() + itemsPerFragment - 1) / itemsPerFragment;
+        if (mFragments.size() < numFragments)
+            mFragments.resize(numFragments);
+        for (size_t i = 0; i < numFragments; i++)
+            prepareFragment(mFragments[i], queue);
+
+        workQueue->parallelFor(0, numFragments, [this, itemsPerFragment](size_t i) {
+            Fragment& f = mFragments[i];
+            size_t end = std::min((i + 1) * itemsPerFragment, mItems.size());
+            for (size_t j = i * itemsPerFragment; j < end; j++)
+            {
+                if (mItems[j].subtree)
+                    cullSubtree(mItems[j].node, f);
+                else
+                    cullObjects(mItems[j].node, f);
+            }
+        });
+
+        DebugDrawer* debugDrawer = root->getCreator() ? root->getCreator()->getDebugDrawer() : NULL;
+        for (size_t i = 0; i < numFragments; i++)
+        {
+            Fragment& f = mFragments[i];
+            queue->merge(f.queue.get());
+            if (visibleBounds)
+                visibleBounds->merge(f.bounds);
+
+            if (debugDrawer)
+            {
+                for (auto n : f.nodes)
+                    debugDrawer->drawSceneNode(n);
+            }
+
+            // drop the pass maps, as the fragments miss the notifications about destroyed passes
+            // the flat lists of sort keys hold no passes after clearing, so they can be kept
+            for (auto& g : f.queue->_getQueueGroups())
+            {
+                if (g)
+                    g->clear(!f.queue->getSortKeysEnabled());
+            }
+        }
+    }
+} // namespace Ogre
@@ -0,0 +1,76 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#ifndef __ParallelSceneCuller_H__
+#define __ParallelSceneCuller_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreSceneManager.h"
+
+namespace Ogre
+{
+/** \addtogroup Core
+ *  @{
+ */
+/** \addtogroup Scene
+ *  @{
+ */
+/** Distributes SceneNode::_findVisibleObjects over the WorkQueue
+
+    The top of the hierarchy is culled on the calling thread until enough independent
+    subtrees are found. Consecutive ranges of these are then culled concurrently, each into its
+    own RenderQueue fragment, which are merged into the target queue in hierarchy order. The
+    resulting queue contents are therefore the same as with the serial traversal.
+
+    The fragments are kept between frames to avoid reallocating the queue structures.
+*/
+class ParallelSceneCuller : public SceneMgtAlloc
+{
+public:
+    ParallelSceneCuller();
+    ~ParallelSceneCuller();
+
+    /** Same as root->_findVisibleObjects(cam, queue, visibleBounds, true, false, onlyShadowCasters)
+
+        Debug drawing of the visible nodes happens on the calling thread, after the fragments
+        were merged.
+    */
+    void findVisibleObjects(SceneNode* root, Camera* cam, RenderQueue* queue,
+                            VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters,
+                            WorkQueue* workQueue);
+
+private:
+    struct Fragment
+    {
+        std::unique_ptr<RenderQueue> queue;
+        VisibleObjectsBoundsInfo bounds;
+        /// visible nodes, for debug drawing
+        std::vector<SceneNode*> nodes;
+    };
+
+    /// a node of which either only the attached objects or the whole subtree is culled
+    struct WorkItem
+    {
+        SceneNode* node;
+        bool subtree;
+    };
+
+    void prepareFragment(Fragment& f, RenderQueue* target);
+    void cullSubtree(SceneNode* node, Fragment& f);
+    void cullObjects(SceneNode* node, Fragment& f);
+
+    std::vector<WorkItem> mItems;
+    std::vector<Fragment> mFragments;
+
+    // per call state, read by the workers
+    Camera* mCamera;
+    bool mOnlyShadowCasters;
+    bool mCollectBounds;
+};
+/** @} */
+/** @} */
+} // namespace Ogre
+
+#endif
@@ -147,11 +147,11 @@ namespace Ogre {
 
     //---------------------------------------------------------------------
     // Performs CPUID instruction with 'query', fill the results, and return value of eax.
-    static uint _performCpuid(int query, CpuidResult& result)
+    static uint _performCpuid(int query, CpuidResult& result, int subQuery = 0)
     {
 #if OGRE_COMPILER == OGRE_COMPILER_MSVC
         int CPUInfo[4];
-        __cpuid(CPUInfo, query);
+        __cpuidex(CPUInfo, query, subQuery);
         result._eax = CPUInfo[0];
         result._ebx = CPUInfo[1];
         result._ecx = CPUInfo[2];
@@ -161,7 +161,7 @@ namespace Ogre {
         #if OGRE_ARCH_TYPE == OGRE_ARCHITECTURE_64
         __asm__
         (
-            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query)
+            "cpuid": "=a" (result._eax), "=b" (result._ebx), "=c" (result._ecx), "=d" (result._edx) : "a" (query), "c" (subQuery)
         );
         #else
         __asm__
@@ -171,7 +171,7 @@ namespace Ogre {
             "movl   %%ebx, %%edi    \n\t"
             "popl   %%ebx           \n\t"
             : "=a" (result._eax), "=D" (result._ebx), "=c" (result._ecx), "=d" (result._edx)
-            : "a" (query)
+            : "a" (query), "c" (subQuery)
         );
        #endif // OGRE_ARCHITECTURE_64
         return result._eax;
@@ -186,6 +186,22 @@ namespace Ogre {
 #pragma warning(pop)
 #endif
 
+    //---------------------------------------------------------------------
+    // Reads the extended control register 0, which tells the register states the OS saves.
+    // Must only be called if CPUID reports OSXSAVE.
+    static uint64 _readXcr0(void)
+    {
+#if OGRE_COMPILER == OGRE_COMPILER_MSVC
+        return _xgetbv(0);
+#elif (OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG) && OGRE_PLATFORM != OGRE_PLATFORM_EMSCRIPTEN
+        uint eax, edx;
+        __asm__ (".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (0)); // xgetbv
+        return (uint64(edx) << 32) | eax;
+#else
+        return 0;
+#endif
+    }
+
     //---------------------------------------------------------------------
     // Detect whether or not os support Streaming SIMD Extension.
 #if OGRE_COMPILER == OGRE_COMPILER_GNUC || OGRE_COMPILER == OGRE_COMPILER_CLANG
@@ -262,6 +278,8 @@ namespace Ogre {
     // Compiler-independent routines
     //---------------------------------------------------------------------
 
+    static uint queryAvxFeatures(uint maxStandardFunction, const CpuidResult& standardFeatures);
+
     static uint queryCpuFeatures(void)
     {
 
@@ -282,6 +300,14 @@ namespace Ogre {
 #define CPUID_STD_SSE3              (1<<0)      // ECX[0]  - Bit 0 of standard function 1 indicate SSE3 supported
 #define CPUID_STD_SSE41             (1<<19)     // ECX[19] - Bit 0 of standard function 1 indicate SSE41 supported
 #define CPUID_STD_SSE42             (1<<20)     // ECX[20] - Bit 0 of standard function 1 indicate SSE42 supported
+#define CPUID_STD_FMA               (1<<12)     // ECX[12] - Bit 12 of standard function 1 indicate FMA supported
+#define CPUID_STD_OSXSAVE           (1<<27)     // ECX[27] - Bit 27 of standard function 1 indicate the OS uses XSAVE
+#define CPUID_STD_AVX               (1<<28)     // ECX[28] - Bit 28 of standard function 1 indicate AVX supported
+
+#define CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES 0x7
+#define CPUID_SEF_AVX2              (1<<5)      // EBX[5] - Bit 5 of function 7 indicate AVX2 supported
+
+#define XCR0_SSE_AVX_STATE          0x6         // XMM and YMM registers are saved by the OS
 
 #define CPUID_FAMILY_ID_MASK        0x0F00      // EAX[11:8] - Bit 11 thru 8 contains family  processor id
 #define CPUID_EXT_FAMILY_ID_MASK    0x0F00000   // EAX[23:20] - Bit 23 thru 20 contains extended family processor id
@@ -302,7 +328,8 @@ namespace Ogre {
             CpuidResult result;
 
             // Has standard feature ?
-            if (_performCpuid(CPUID_FUNC_VENDOR_ID, result))
+            const uint maxStandardFunction = _performCpuid(CPUID_FUNC_VENDOR_ID, result);
+            if (maxStandardFunction)
             {
                 // Check vendor strings
                 if (memcmp(&result._ebx, "GenuineIntel", 12) == 0)
@@ -331,6 +358,7 @@ namespace Ogre {
                         features |= PlatformInformation::CPU_FEATURE_SSE41;
                     if (result._ecx & CPUID_STD_SSE42)
                         features |= PlatformInformation::CPU_FEATURE_SSE42;
+                    features |= queryAvxFeatures(maxStandardFunction, result);
 
                     // Check to see if this is a Pentium 4 or later processor
                     if ((result._eax & CPUID_EXT_FAMILY_ID_MASK) ||
@@ -373,6 +401,7 @@ namespace Ogre {
 
                     if (result._ecx & CPUID_STD_SSE3)
                         features |= PlatformInformation::CPU_FEATURE_SSE3;
+                    features |= queryAvxFeatures(maxStandardFunction, result);
 
                     // Has extended feature ?
                     const uint maxExtensionFunctionSupport = _performCpuid(CPUID_FUNC_EXTENSION_QUERY, result);
@@ -404,6 +433,28 @@ namespace Ogre {
         return features;
     }
     //---------------------------------------------------------------------
+    // Detects AVX, AVX2 and FMA, given the result of the standard features query. These are only
+    // usable if the OS saves the YMM registers on context switches.
+    static uint queryAvxFeatures(uint maxStandardFunction, const CpuidResult& standardFeatures)
+    {
+        if (!(standardFeatures._ecx & CPUID_STD_AVX) || !(standardFeatures._ecx & CPUID_STD_OSXSAVE) ||
+            (_readXcr0() & XCR0_SSE_AVX_STATE) != XCR0_SSE_AVX_STATE)
+            return 0;
+
+        uint features = PlatformInformation::CPU_FEATURE_AVX;
+        if (standardFeatures._ecx & CPUID_STD_FMA)
+            features |= PlatformInformation::CPU_FEATURE_FMA;
+
+        if (maxStandardFunction >= CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES)
+        {
+            CpuidResult result;
+            _performCpuid(CPUID_FUNC_STRUCTURED_EXTENDED_FEATURES, result, 0);
+            if (result._ebx & CPUID_SEF_AVX2)
+                features |= PlatformInformation::CPU_FEATURE_AVX2;
+        }
+        return features;
+    }
+    //---------------------------------------------------------------------
     static uint _detectCpuFeatures(void)
     {
         uint features = queryCpuFeatures();
@@ -707,6 +758,12 @@ namespace Ogre {
                 " *          PRO: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_PRO), true));
             pLog->logMessage(
                 " *           HT: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_HTT), true));
+            pLog->logMessage(
+                " *          AVX: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX), true));
+            pLog->logMessage(
+                " *         AVX2: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_AVX2), true));
+            pLog->logMessage(
+                " *          FMA: " + StringConverter::toString(hasCpuFeature(CPU_FEATURE_FMA), true));
         }
 #elif OGRE_CPU == OGRE_CPU_ARM || OGRE_PLATFORM == OGRE_PLATFORM_ANDROID
         pLog->logMessage(
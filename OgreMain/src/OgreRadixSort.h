@@ -82,7 +82,8 @@ namespace Ogre {
         implementation can handle both unsigned and signed integers, as well as
         floats (which are often not supported by other radix sorters). doubles
         are not supported; you will need to implement your functor object to convert
-        to float if you wish to use this sort routine.
+        to float if you wish to use this sort routine. 64 bit unsigned integers are
+        supported, which allows sorting by several values packed into one key.
     */
     template <class TContainer, class TContainerValueType, typename TCompValueType>
     class RadixSort
@@ -90,9 +91,8 @@ namespace Ogre {
     public:
         typedef typename TContainer::iterator ContainerIter;
     protected:
-        /// Alpha-pass counters of values (histogram)
-        /// 4 of them so we can radix sort a maximum of a 32bit value
-        int mCounters[4][256];
+        /// Alpha-pass counters of values (histogram), one per byte of the value
+        int mCounters[sizeof(TCompValueType)][256];
         /// Beta-pass offsets 
         int mOffsets[256];
         /// Sort area size
@@ -309,6 +309,10 @@ namespace Ogre {
 
             for (p = 0; p < mNumPasses - 1; ++p)
             {
+                // skip bytes which are the same for all values, e.g. the upper ones of small keys
+                if (mCounters[p][getByte(p, prevValue)] == mSortSize)
+                    continue;
+
                 sortPass(p);
                 // flip src/dst
                 SortVector* tmp = mSrc;
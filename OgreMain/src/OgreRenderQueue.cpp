@@ -41,6 +41,7 @@ namespace Ogre {
         : mSplitPassesByLightingType(false)
         , mSplitNoShadowPasses(false)
         , mShadowCastersCannotBeReceivers(false)
+        , mSortKeysEnabled(false)
         , mRenderableListener(0)
     {
         // Create the 'main' queue up-front since we'll always need that
@@ -183,6 +184,7 @@ namespace Ogre {
             // Insert new
             mGroups[groupID] = std::make_unique<RenderQueueGroup>(mSplitPassesByLightingType, mSplitNoShadowPasses,
                                                         mShadowCastersCannotBeReceivers);
+            mGroups[groupID]->setSortKeysEnabled(mSortKeysEnabled);
         }
 
         return mGroups[groupID].get();
@@ -237,6 +239,17 @@ namespace Ogre {
         return mShadowCastersCannotBeReceivers;
     }
     //-----------------------------------------------------------------------
+    void RenderQueue::setSortKeysEnabled(bool enabled)
+    {
+        mSortKeysEnabled = enabled;
+
+        for (auto & g : mGroups)
+        {
+            if(g)
+                g->setSortKeysEnabled(enabled);
+        }
+    }
+    //-----------------------------------------------------------------------
     void RenderQueue::merge( const RenderQueue* rhs )
     {
         for (size_t i = 0; i < RENDER_QUEUE_COUNT; ++i)
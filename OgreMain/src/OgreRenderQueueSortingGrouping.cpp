@@ -93,6 +93,38 @@ namespace {
             return static_cast<float>(- p.renderable->getSquaredViewDepth(camera));
         }
     };
+
+    /** Functor for the 64 bit sort key, distance in the upper and pass hash in the lower bits
+
+        This sorts ascending and is visited in reverse for descending distance. The radix sort by
+        negative distance above reverses the order of equal distances the same way.
+    */
+    struct RadixSortFunctorSortKey
+    {
+        const Camera* camera;
+
+        RadixSortFunctorSortKey(const Camera* cam)
+            : camera(cam)
+        {
+        }
+
+        uint64 operator()(const RenderablePass& p) const
+        {
+            float depth = static_cast<float>(p.renderable->getSquaredViewDepth(camera));
+            uint32 bits;
+            memcpy(&bits, &depth, sizeof(bits));
+            // flip the bits, so the unsigned key orders like the float
+            bits = (bits & 0x80000000) ? ~bits : bits | 0x80000000;
+            return (uint64(bits) << 32) | p.pass->getHash();
+        }
+    };
+
+    template<typename Iterator>
+    void visitRenderablePasses(QueuedRenderableVisitor* visitor, Iterator begin, Iterator end)
+    {
+        for (; begin != end; ++begin)
+            visitor->visit(const_cast<RenderablePass*>(&(*begin)));
+    }
 }
     //-----------------------------------------------------------------------
     RenderPriorityGroup::RenderPriorityGroup(RenderQueueGroup* parent, 
@@ -280,6 +312,16 @@ namespace {
         mTransparents.sort(cam);
     }
     //-----------------------------------------------------------------------
+    void RenderPriorityGroup::setSortKeysEnabled(bool enabled)
+    {
+        mSolidsBasic.setSortKeysEnabled(enabled);
+        mSolidsDiffuseSpecular.setSortKeysEnabled(enabled);
+        mSolidsDecal.setSortKeysEnabled(enabled);
+        mSolidsNoShadowReceive.setSortKeysEnabled(enabled);
+        mTransparentsUnsorted.setSortKeysEnabled(enabled);
+        mTransparents.setSortKeysEnabled(enabled);
+    }
+    //-----------------------------------------------------------------------
     void RenderPriorityGroup::merge( const RenderPriorityGroup* rhs )
     {
         mSolidsBasic.merge( rhs->mSolidsBasic );
@@ -291,7 +333,7 @@ namespace {
     }
     //-----------------------------------------------------------------------
     QueuedRenderableCollection::QueuedRenderableCollection(void)
-        :mOrganisationMode(0)
+        :mOrganisationMode(0), mSortKeysEnabled(false)
     {
     }
 
@@ -306,6 +348,7 @@ namespace {
 
         // Clear sorted list
         mSortedDescending.clear();
+        mGroupedFlat.clear();
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::removePassGroup(Pass* p)
@@ -326,6 +369,33 @@ namespace {
         static RadixSort<RenderablePassList, RenderablePass, uint32> msRadixSorter1;
         /// Radix sorter for sort value 2 (distance)
         static RadixSort<RenderablePassList, RenderablePass, float> msRadixSorter2;
+        /// Radix sorter for the combined distance and pass key
+        static RadixSort<RenderablePassList, RenderablePass, uint64> msRadixSorterKey;
+
+        if (mSortKeysEnabled)
+        {
+            if (mOrganisationMode & OM_SORT_DESCENDING)
+                msRadixSorterKey.sort(mSortedDescending, RadixSortFunctorSortKey(cam));
+
+            if (mOrganisationMode & OM_PASS_GROUP)
+            {
+                msRadixSorter1.sort(mGroupedFlat, RadixSortFunctorPass());
+
+                // passes with the same hash are ordered by address like in the pass map
+                auto passLess = [](const RenderablePass& a, const RenderablePass& b) { return a.pass < b.pass; };
+                for (auto begin = mGroupedFlat.begin(); begin != mGroupedFlat.end();)
+                {
+                    uint32 hash = begin->pass->getHash();
+                    auto end = begin + 1;
+                    while (end != mGroupedFlat.end() && end->pass->getHash() == hash)
+                        ++end;
+                    if (!std::is_sorted(begin, end, passLess))
+                        std::stable_sort(begin, end, passLess);
+                    begin = end;
+                }
+            }
+            return;
+        }
 
         // ascending and descending sort both set bit 1
         // We always sort descending, because the only difference is in the
@@ -371,7 +441,11 @@ namespace {
             mSortedDescending.push_back(RenderablePass(rend, pass));
         }
 
-        if (mOrganisationMode & OM_PASS_GROUP)
+        if ((mOrganisationMode & OM_PASS_GROUP) && mSortKeysEnabled)
+        {
+            mGroupedFlat.push_back(RenderablePass(rend, pass));
+        }
+        else if (mOrganisationMode & OM_PASS_GROUP)
         {
             // Optionally create new pass entry, build a new list
             // Note that this pass and list are never destroyed until the
@@ -423,6 +497,22 @@ namespace {
     void QueuedRenderableCollection::acceptVisitorGrouped(
         QueuedRenderableVisitor* visitor) const
     {
+        if (mSortKeysEnabled)
+        {
+            // visit the runs of the same pass
+            for (auto begin = mGroupedFlat.begin(); begin != mGroupedFlat.end();)
+            {
+                mVisitedGroup.clear();
+                auto end = begin;
+                for (; end != mGroupedFlat.end() && end->pass == begin->pass; ++end)
+                    mVisitedGroup.push_back(end->renderable);
+
+                visitor->visit(begin->pass, mVisitedGroup);
+                begin = end;
+            }
+            return;
+        }
+
         for (auto& ipass : mGrouped)
         {
             // Fast bypass if this group is now empty
@@ -437,30 +527,43 @@ namespace {
         QueuedRenderableVisitor* visitor) const
     {
         // List is already in descending order, so iterate forward
-        for (const auto& i : mSortedDescending)
-        {
-            visitor->visit(const_cast<RenderablePass*>(&i));
-        }
+        // unless sorted ascending by key
+        if (mSortKeysEnabled)
+            visitRenderablePasses(visitor, mSortedDescending.rbegin(), mSortedDescending.rend());
+        else
+            visitRenderablePasses(visitor, mSortedDescending.begin(), mSortedDescending.end());
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::acceptVisitorAscending(
         QueuedRenderableVisitor* visitor) const
     {
         // List is in descending order, so iterate in reverse
-        RenderablePassList::const_reverse_iterator i, iend;
-
-        iend = mSortedDescending.rend();
-        for (i = mSortedDescending.rbegin(); i != iend; ++i)
-        {
-            visitor->visit(const_cast<RenderablePass*>(&(*i)));
-        }
-
+        // unless sorted ascending by key
+        if (mSortKeysEnabled)
+            visitRenderablePasses(visitor, mSortedDescending.begin(), mSortedDescending.end());
+        else
+            visitRenderablePasses(visitor, mSortedDescending.rbegin(), mSortedDescending.rend());
     }
     //-----------------------------------------------------------------------
     void QueuedRenderableCollection::merge( const QueuedRenderableCollection& rhs )
     {
         mSortedDescending.insert( mSortedDescending.end(), rhs.mSortedDescending.begin(), rhs.mSortedDescending.end() );
 
+        // the collections might order by pass differently
+        if (mSortKeysEnabled)
+        {
+            mGroupedFlat.insert(mGroupedFlat.end(), rhs.mGroupedFlat.begin(), rhs.mGroupedFlat.end());
+            for (const auto& srcGroup : rhs.mGrouped)
+            {
+                for (auto* rend : srcGroup.second)
+                    mGroupedFlat.push_back(RenderablePass(rend, srcGroup.first));
+            }
+            return;
+        }
+
+        for (const auto& rp : rhs.mGroupedFlat)
+            mGrouped.emplace(rp.pass, RenderableList()).first->second.push_back(rp.renderable);
+
         for (const auto& srcGroup : rhs.mGrouped)
         {
             // Optionally create new pass entry, build a new list
@@ -55,7 +55,7 @@ namespace Ogre {
     //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
     ResourceGroupManager::ResourceGroupManager()
-        : mLoadingListener(0), mCurrentGroup(0)
+        : mLoadingListener(0), mParallelLoading(false), mCurrentGroup(0)
     {
         // Create the 'General' group
         createResourceGroup(DEFAULT_RESOURCE_GROUP_NAME, true); // the "General" group is synonymous to global pool
@@ -215,6 +215,9 @@ namespace Ogre {
         LogManager::getSingleton().stream() << "Loading resource group '" << name << "'";
         // load all created resources
         ResourceGroup* grp = getResourceGroup(name, true);
+        // before locking, as the workers open the resources through us
+        if (mParallelLoading)
+            prepareResourcesParallel(grp);
         OGRE_LOCK_AUTO_MUTEX;
         OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex 
         // Set current group
@@ -277,6 +280,36 @@ namespace Ogre {
         LogManager::getSingleton().logMessage("Finished loading resource group " + name);
     }
     //-----------------------------------------------------------------------
+    void ResourceGroupManager::prepareResourcesParallel(ResourceGroup* grp)
+    {
+        std::vector<Resource*> resources;
+        {
+            OGRE_LOCK_MUTEX(grp->OGRE_AUTO_MUTEX_NAME); // lock group mutex
+            for (auto& oi : grp->loadResourceOrderMap)
+            {
+                for (auto& res : oi.second)
+                {
+                    // manual loaders might not be thread safe and deriving the group changes ours
+                    if (res->getLoadingState() == Resource::LOADSTATE_UNLOADED && !res->isManuallyLoaded() &&
+                        !res->isBackgroundLoaded() && res->getGroup() != AUTODETECT_RESOURCE_GROUP_NAME)
+                        resources.push_back(res.get());
+                }
+            }
+        }
+
+        Root::getSingleton().getWorkQueue()->parallelFor(0, resources.size(), [&resources](size_t i) {
+            try
+            {
+                // background, so the preparing complete event is not fired on a worker
+                resources[i]->prepare(true);
+            }
+            catch (const std::exception&)
+            {
+                // the resource is unloaded again and load will report the error in order
+            }
+        });
+    }
+    //-----------------------------------------------------------------------
     void ResourceGroupManager::unloadResourceGroup(const String& name, bool reloadableOnly)
     {
         LogManager::getSingleton().logMessage("Unloading resource group " + name);
@@ -798,17 +831,48 @@ namespace Ogre {
 
             scriptCount += scriptLoaderFileList.back().second.size();
         }
+        // Read and tokenize the scripts concurrently, the listener expects streams to be opened in order
+        std::vector<Any> preparedScripts(scriptCount);
+        if (mParallelLoading && !mLoadingListener)
+        {
+            std::vector<std::pair<ScriptLoader*, const FileInfo*>> scripts;
+            for (auto& slfli : scriptLoaderFileList)
+            {
+                for (auto& fii : slfli.second)
+                    scripts.emplace_back(slfli.first, &fii);
+            }
+
+            Root::getSingleton().getWorkQueue()->parallelFor(0, scripts.size(), [&](size_t i) {
+                try
+                {
+                    const FileInfo* fi = scripts[i].second;
+                    if (DataStreamPtr stream = fi->archive->open(fi->filename))
+                    {
+                        if (!dynamic_cast<MemoryDataStream*>(stream.get()))
+                            stream.reset(OGRE_NEW MemoryDataStream(stream->getName(), stream));
+                        preparedScripts[i] = scripts[i].first->prepareScript(stream);
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    // parsed again below, where the error is reported
+                }
+            });
+        }
+
         // Fire scripting event
         fireResourceGroupScriptingStarted(grp->name, scriptCount);
 
         // Iterate over scripts and parse
         // Note we respect original ordering
+        size_t scriptIndex = 0;
         for (auto & slfli : scriptLoaderFileList)
         {
             ScriptLoader* su = slfli.first;
             // Iterate over each item in the list
             for (auto & fii : slfli.second)
             {
+                const Any& prepared = preparedScripts[scriptIndex++];
                 bool skipScript = false;
                 fireScriptStarted(fii.filename, skipScript);
                 if(skipScript)
@@ -816,6 +880,12 @@ namespace Ogre {
                     LogManager::getSingleton().logMessage(
                         "Skipping script " + fii.filename);
                 }
+                else if (prepared.has_value())
+                {
+                    LogManager::getSingleton().logMessage(
+                        "Parsing script " + fii.filename);
+                    su->parsePreparedScript(prepared, grp->name);
+                }
                 else
                 {
                     LogManager::getSingleton().logMessage(
@@ -826,7 +896,8 @@ namespace Ogre {
                         if (mLoadingListener)
                             mLoadingListener->resourceStreamOpened(fii.filename, grp->name, 0, stream);
 
-                        if(fii.archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024)
+                        if(fii.archive->getType() == "FileSystem" && stream->size() <= 1024 * 1024 &&
+                           !dynamic_cast<MemoryDataStream*>(stream.get()))
                         {
                             DataStreamPtr cachedCopy(OGRE_NEW MemoryDataStream(stream->getName(), stream));
                             su->parseScript(cachedCopy, grp->name);
@@ -52,6 +52,7 @@ THE SOFTWARE.
 #include "OgreFileSystemLayer.h"
 #include "OgreStaticGeometry.h"
 #include "OgreSceneManagerEnumerator.h"
+#include "OgreFrameTaskGraph.h"
 
 #if OGRE_NO_DDS_CODEC == 0
 #include "OgreDDSCodec.h"
@@ -155,6 +156,26 @@ namespace Ogre {
         defaultQ->setWorkersCanAccessRenderSystem(OGRE_THREAD_SUPPORT == 1);
         mWorkQueue.reset(defaultQ);
 
+        // the engine's per frame jobs, on the main thread as controllers and animations can target anything
+        mFrameTaskGraph = std::make_unique<FrameTaskGraph>();
+        auto controllers = mFrameTaskGraph->addJob(
+            "Controllers",
+            [this]()
+            {
+                // created by initialise
+                if (mControllerManager)
+                    mControllerManager->updateAllControllers();
+            },
+            {}, true);
+        mFrameTaskGraph->addJob(
+            "SceneAnimations",
+            [this]()
+            {
+                for (const auto& it : getSceneManagers())
+                    it.second->_updateSceneAnimations();
+            },
+            {controllers}, true);
+
         // ResourceBackgroundQueue
         mResourceBackgroundQueue = std::make_unique<ResourceBackgroundQueue>();
 
@@ -784,6 +805,8 @@ namespace Ogre {
         if(!_fireFrameStarted())
             return false;
 
+        mFrameTaskGraph->run(mWorkQueue.get());
+
         if (!_updateAllRenderTargets())
             return false;
 
@@ -801,6 +824,8 @@ namespace Ogre {
         if(!_fireFrameStarted(evt))
             return false;
 
+        mFrameTaskGraph->run(mWorkQueue.get());
+
         if (!_updateAllRenderTargets(evt))
             return false;
 
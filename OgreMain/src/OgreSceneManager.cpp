@@ -44,6 +44,10 @@ THE SOFTWARE.
 #include "OgreRenderTexture.h"
 #include "OgreLodListener.h"
 #include "OgreDefaultDebugDrawer.h"
+#include "OgreNodeTransformStore.h"
+#include "OgreParallelSceneCuller.h"
+#include "OgreSoftwareSkinningBatch.h"
+#include "OgreStaticDrawList.h"
 
 // This class implements the most basic scene manager
 
@@ -64,6 +68,7 @@ mFogDensity(0),
 mSpecialCaseQueueMode(SCRQM_EXCLUDE),
 mWorldGeometryRenderQueue(RENDER_QUEUE_WORLD_GEOMETRY_1),
 mLastFrameNumber(0),
+mLastAnimationFrameNumber(0),
 mResetIdentityView(false),
 mResetIdentityProj(false),
 mFlipCullingOnNegativeScale(true),
@@ -78,6 +83,8 @@ mShadowRenderer(this),
 mLightClippingInfoMapFrameNumber(999),
 mVisibilityMask(0xFFFFFFFF),
 mFindVisibleObjects(true),
+mParallelSceneGraphUpdate(false),
+mStaticDrawRecording(NULL),
 mCameraRelativeRendering(false),
 mLastLightHash(0),
 mGpuParamsDirty((uint16)GPV_ALL)
@@ -100,6 +107,8 @@ mGpuParamsDirty((uint16)GPV_ALL)
 //-----------------------------------------------------------------------
 SceneManager::~SceneManager()
 {
+    // flush pending blends, while the buffers still exist
+    mSoftwareSkinningBatch.reset();
     fireSceneManagerDestroyed();
     clearScene();
     destroyAllCameras();
@@ -944,12 +953,13 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
     // Update controllers 
     ControllerManager::getSingleton().updateAllControllers();
 
+    // Update animations, unless Root did already
+    _updateSceneAnimations();
+
     // Update the scene, only do this once per frame
     unsigned long thisFrameNumber = Root::getSingleton().getNextFrameNumber();
     if (thisFrameNumber != mLastFrameNumber)
     {
-        // Update animations
-        _applySceneAnimations();
         updateDirtyInstanceManagers();
         mLastFrameNumber = thisFrameNumber;
     }
@@ -1046,8 +1056,10 @@ void SceneManager::_renderScene(Camera* camera, Viewport* vp, bool includeOverla
 
             // Parse the scene and tag visibles
             firePreFindVisibleObjects(vp);
+            _beginSoftwareSkinning();
             _findVisibleObjects(camera, &(camVisObjIt->second),
                 mIlluminationStage == IRS_RENDER_TO_TEXTURE? true : false);
+            _endSoftwareSkinning();
             firePostFindVisibleObjects(vp);
 
             mAutoParamDataSource->setMainCamBoundsInfo(&(camVisObjIt->second));
@@ -1251,14 +1263,83 @@ void SceneManager::_updateSceneGraph(Camera* cam)
     // In this implementation, just update from the root
     // Smarter SceneManager subclasses may choose to update only
     //   certain scene graph branches
-    getRootSceneNode()->_update(true, false);
+    WorkQueue* queue = mParallelSceneGraphUpdate ? Root::getSingleton().getWorkQueue() : NULL;
+    if (mNodeTransformStore)
+    {
+        if (mNodeTransformStore->isLayoutChanged())
+            mNodeTransformStore->build(getRootSceneNode());
+        mNodeTransformStore->update(queue);
+    }
+    else if (queue)
+        getRootSceneNode()->_updateParallel(queue);
+    else
+        getRootSceneNode()->_update(true, false);
 
     firePostUpdateSceneGraph(cam);
 }
 //-----------------------------------------------------------------------
+void SceneManager::setNodeTransformStoreEnabled(bool enabled)
+{
+    if (!enabled)
+        mNodeTransformStore.reset();
+    else if (!mNodeTransformStore)
+        mNodeTransformStore = std::make_unique<NodeTransformStore>();
+}
+//-----------------------------------------------------------------------
+void SceneManager::_notifySceneGraphLayoutChanged()
+{
+    if (mNodeTransformStore)
+        mNodeTransformStore->_notifyLayoutChanged();
+}
+//-----------------------------------------------------------------------
+void SceneManager::setParallelFindVisibleObjects(bool enabled)
+{
+    if (!enabled)
+        mParallelSceneCuller.reset();
+    else if (!mParallelSceneCuller)
+        mParallelSceneCuller = std::make_unique<ParallelSceneCuller>();
+}
+//-----------------------------------------------------------------------
+void SceneManager::setParallelSoftwareSkinning(bool enabled)
+{
+    if (!enabled)
+        mSoftwareSkinningBatch.reset();
+    else if (!mSoftwareSkinningBatch)
+        mSoftwareSkinningBatch = std::make_unique<SoftwareSkinningBatch>();
+}
+//-----------------------------------------------------------------------
+void SceneManager::_beginSoftwareSkinning()
+{
+    if (mSoftwareSkinningBatch)
+        mSoftwareSkinningBatch->begin();
+}
+//-----------------------------------------------------------------------
+void SceneManager::_endSoftwareSkinning()
+{
+    if (mSoftwareSkinningBatch && mSoftwareSkinningBatch->isOpen())
+        mSoftwareSkinningBatch->end(Root::getSingleton().getWorkQueue());
+}
+//-----------------------------------------------------------------------
+bool SceneManager::_queueSoftwareVertexBlend(const VertexData* sourceVertexData,
+                                             const VertexData* targetVertexData,
+                                             const Affine3* const* blendMatrices, size_t numMatrices,
+                                             bool blendNormals)
+{
+    return mSoftwareSkinningBatch &&
+           mSoftwareSkinningBatch->add(sourceVertexData, targetVertexData, blendMatrices, numMatrices, blendNormals);
+}
+//-----------------------------------------------------------------------
 void SceneManager::_findVisibleObjects(
     Camera* cam, VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters)
 {
+    WorkQueue* queue = mParallelSceneCuller ? Root::getSingleton().getWorkQueue() : NULL;
+    if (queue && !getRenderQueue()->getRenderableListener())
+    {
+        mParallelSceneCuller->findVisibleObjects(getRootSceneNode(), cam, getRenderQueue(), visibleBounds,
+                                                 onlyShadowCasters, queue);
+        return;
+    }
+
     // Tell nodes to find, cascade down all nodes
     getRootSceneNode()->_findVisibleObjects(cam, getRenderQueue(), visibleBounds, true, 
         mDisplayNodes, onlyShadowCasters);
@@ -1507,17 +1588,69 @@ void SceneManager::renderBasicQueueGroupObjects(RenderQueueGroup* pGroup,
     // Iterate through priorities
     auto visitor = mActiveQueuedRenderableVisitor;
 
+    // Sort the queue first
     for (const auto& pg : pGroup->getPriorityGroups())
+        pg.second->sort(mCameraInProgress);
+
+    StaticDrawList* drawList = pGroup->isStatic() ? getStaticDrawList(pGroup) : NULL;
+    if (drawList && drawList->update(pGroup, om, mCameraInProgress, mLightsDirtyCounter))
     {
-        RenderPriorityGroup* pPriorityGrp = pg.second;
+        renderStaticDraws(*drawList);
+        return;
+    }
+    if (drawList)
+        mStaticDrawRecording = drawList;
 
-        // Sort the queue first
-        pPriorityGrp->sort(mCameraInProgress);
+    for (const auto& pg : pGroup->getPriorityGroups())
+    {
+        RenderPriorityGroup* pPriorityGrp = pg.second;
 
         // Do solids
         visitor->renderObjects(pPriorityGrp->getSolidsBasic(), om, true, true);
         visitor->renderTransparents(pPriorityGrp, om);
     }// for each priority
+
+    if (drawList)
+        drawList->endRecording();
+    mStaticDrawRecording = NULL;
+}
+//-----------------------------------------------------------------------
+StaticDrawList* SceneManager::getStaticDrawList(const RenderQueueGroup* pGroup)
+{
+    // the recording only covers the state derived in renderSingleObject, which must not
+    // depend on anything else than the queue contents, the camera and the lights
+    if (mActiveQueuedRenderableVisitor != &mDefaultQueuedRenderableVisitor || !mRenderObjectListeners.empty() ||
+        isLateMaterialResolving() || mIlluminationStage != IRS_NONE || isShadowTechniqueTextureBased())
+        return NULL;
+
+    auto& drawList = mStaticDrawLists[pGroup];
+    if (!drawList)
+        drawList = std::make_unique<StaticDrawList>();
+    return drawList.get();
+}
+//-----------------------------------------------------------------------
+void SceneManager::renderStaticDraws(const StaticDrawList& drawList)
+{
+    const Pass* pass = NULL;
+    for (const auto& draw : drawList.getDraws())
+    {
+        if (draw.pass != pass)
+            pass = _setPass(draw.pass);
+
+        mAutoParamDataSource->setCurrentRenderable(draw.renderable);
+        setWorldTransform(draw.renderable);
+
+        if (draw.cullingMode != mDestRenderSystem->_getCullingMode())
+            mDestRenderSystem->_setCullingMode(draw.cullingMode);
+        mDestRenderSystem->_setPolygonMode(draw.polygonMode);
+        mDestRenderSystem->setDeriveDepthBias(false);
+
+        useLights(&drawList.getLightLists()[draw.lights], pass->getMaxSimultaneousLights());
+        mDestRenderSystem->setCurrentPassIterationCount(pass->getPassIterationCount());
+        _issueRenderOp(draw.renderable, pass);
+
+        resetViewProjMode();
+    }
 }
 //-----------------------------------------------------------------------
 void SceneManager::setWorldTransform(Renderable* rend)
@@ -1541,10 +1674,40 @@ void SceneManager::setWorldTransform(Renderable* rend)
     mGpuParamsDirty |= (uint16)GPV_PER_OBJECT;
 }
 //-----------------------------------------------------------------------
+static PolygonMode derivePolygonMode(const Pass* pass, const Renderable* rend, const Camera* cam)
+{
+    // Set up the solid / wireframe override
+    // Precedence is Camera, Object, Material
+    // Camera might not override object if not overrideable
+    PolygonMode reqMode = pass->getPolygonMode();
+    if (pass->getPolygonModeOverrideable() && rend->getPolygonModeOverrideable())
+    {
+        PolygonMode camPolyMode = cam->getPolygonMode();
+        // check camera detial only when render detail is overridable
+        if (reqMode > camPolyMode)
+        {
+            // only downgrade detail; if cam says wireframe we don't go up to solid
+            reqMode = camPolyMode;
+        }
+    }
+    return reqMode;
+}
+//-----------------------------------------------------------------------
 void SceneManager::issueRenderWithLights(Renderable* rend, const Pass* pass,
                                          const LightList* pLightListToUse,
                                          bool lightScissoringClipping)
 {
+    if (mStaticDrawRecording)
+    {
+        // scissoring, clipping and depth bias per iteration are not recorded
+        if ((lightScissoringClipping && (pass->getLightScissoringEnabled() || pass->getLightClipPlanesEnabled())) ||
+            pass->getIterationDepthBias() != 0.0f)
+            mStaticDrawRecording->abortRecording();
+        else if (mStaticDrawRecording->isRecording())
+            mStaticDrawRecording->addDraw(rend, pass, pLightListToUse, mDestRenderSystem->_getCullingMode(),
+                                          derivePolygonMode(pass, rend, mCameraInProgress));
+    }
+
     useLights(pLightListToUse, pass->getMaxSimultaneousLights());
     fireRenderSingleObject(rend, pass, mAutoParamDataSource.get(), pLightListToUse, false);
 
@@ -1607,28 +1770,13 @@ static void injectGlobalInstancingDeclaration(RenderOperation& ro, const RenderS
     ro.numberOfInstances *= rs->getGlobalInstanceCount();
 }
 
-static PolygonMode derivePolygonMode(const Pass* pass, const Renderable* rend, const Camera* cam)
-{
-    // Set up the solid / wireframe override
-    // Precedence is Camera, Object, Material
-    // Camera might not override object if not overrideable
-    PolygonMode reqMode = pass->getPolygonMode();
-    if (pass->getPolygonModeOverrideable() && rend->getPolygonModeOverrideable())
-    {
-        PolygonMode camPolyMode = cam->getPolygonMode();
-        // check camera detial only when render detail is overridable
-        if (reqMode > camPolyMode)
-        {
-            // only downgrade detail; if cam says wireframe we don't go up to solid
-            reqMode = camPolyMode;
-        }
-    }
-    return reqMode;
-}
-
 void SceneManager::renderInstancedObject(const RenderableList& rends, const Pass* pass, bool lightScissoringClipping,
                                          bool doLightIteration, const LightList* manualLightList)
 {
+    // instanced draws are not recorded
+    if (mStaticDrawRecording)
+        mStaticDrawRecording->abortRecording();
+
     mAutoParamDataSource->setCurrentRenderable(rends.front());
     // override: this is passed through the instance buffer
     mAutoParamDataSource->setWorldMatrices(&Affine3::IDENTITY, 1);
@@ -2179,6 +2327,16 @@ void SceneManager::_applySceneAnimations(void)
     }
 }
 //---------------------------------------------------------------------
+void SceneManager::_updateSceneAnimations(void)
+{
+    unsigned long thisFrameNumber = Root::getSingleton().getNextFrameNumber();
+    if (thisFrameNumber == mLastAnimationFrameNumber)
+        return;
+
+    _applySceneAnimations();
+    mLastAnimationFrameNumber = thisFrameNumber;
+}
+//---------------------------------------------------------------------
 void SceneManager::manualRender(RenderOperation* rend, 
                                 Pass* pass, Viewport* vp, const Affine3& worldMatrix,
                                 const Affine3& viewMatrix, const Matrix4& projMatrix,
@@ -3580,6 +3738,8 @@ void SceneManager::bindGpuProgram(GpuProgram* prog)
 void SceneManager::_markGpuParamsDirty(uint16 mask)
 {
     mGpuParamsDirty |= mask;
+    // the caller changed state the data source can not track
+    mAutoParamDataSource->_markDirty(GPS_ALL);
 }
 //---------------------------------------------------------------------
 void SceneManager::updateGpuProgramParameters(const Pass* pass)
@@ -3660,6 +3820,16 @@ void VisibleObjectsBoundsInfo::merge(const AxisAlignedBox& boxBounds, const Sphe
     maxDistanceInFrustum = std::max(maxDistanceInFrustum, camDistToCenter + sphereBounds.getRadius());
 }
 //---------------------------------------------------------------------
+void VisibleObjectsBoundsInfo::merge(const VisibleObjectsBoundsInfo& rhs)
+{
+    aabb.merge(rhs.aabb);
+    receiverAabb.merge(rhs.receiverAabb);
+    minDistance = std::min(minDistance, rhs.minDistance);
+    maxDistance = std::max(maxDistance, rhs.maxDistance);
+    minDistanceInFrustum = std::min(minDistanceInFrustum, rhs.minDistanceInFrustum);
+    maxDistanceInFrustum = std::max(maxDistanceInFrustum, rhs.maxDistanceInFrustum);
+}
+//---------------------------------------------------------------------
 void VisibleObjectsBoundsInfo::mergeNonRenderedButInFrustum(const AxisAlignedBox& boxBounds, const Sphere& sphereBounds, const Camera* cam)
 {
     (void)boxBounds;
@@ -62,6 +62,66 @@ namespace Ogre {
         _updateBounds();
     }
     //-----------------------------------------------------------------------
+    void SceneNode::_updateParallel(WorkQueue* queue, bool parentHasChanged)
+    {
+        typedef std::pair<SceneNode*, bool> Subtree; // node, parentHasChanged
+        std::vector<Subtree> subtrees = {{this, parentHasChanged}};
+        // nodes updated on this thread, in breadth first order
+        std::vector<SceneNode*> upperNodes;
+
+        size_t numThreads = queue->getWorkerThreadCount() + 1;
+        size_t minSubtrees = numThreads * 8;
+
+        // descend breadth first until we have enough independent subtrees
+        bool expanded = true;
+        while (subtrees.size() < minSubtrees && expanded)
+        {
+            expanded = false;
+            std::vector<Subtree> next;
+            for (const auto& s : subtrees)
+            {
+                SceneNode* node = s.first;
+                if (node->getChildren().empty())
+                {
+                    // nothing to gain by descending further
+                    next.push_back(s);
+                    continue;
+                }
+
+                // same as Node::_update, but with the children deferred
+                node->mParentNotified = false;
+                if (node->mNeedParentUpdate || s.second)
+                    node->_updateFromParent();
+
+                if (node->mNeedChildUpdate || s.second)
+                {
+                    for (auto c : node->getChildren())
+                        next.emplace_back(static_cast<SceneNode*>(c), true);
+                }
+                else
+                {
+                    for (auto c : node->mChildrenToUpdate)
+                        next.emplace_back(static_cast<SceneNode*>(c), false);
+                }
+                node->mChildrenToUpdate.clear();
+                node->mNeedChildUpdate = false;
+
+                upperNodes.push_back(node);
+                expanded = true;
+            }
+            subtrees.swap(next);
+        }
+
+        size_t grainSize = std::max<size_t>(1, subtrees.size() / (numThreads * 4));
+        queue->parallelFor(
+            0, subtrees.size(), [&subtrees](size_t i) { subtrees[i].first->_update(true, subtrees[i].second); },
+            grainSize);
+
+        // children come after their parents, so this merges the bounds bottom-up
+        for (auto it = upperNodes.rbegin(); it != upperNodes.rend(); ++it)
+            (*it)->_updateBounds();
+    }
+    //-----------------------------------------------------------------------
     void SceneNode::setParent(Node* parent)
     {
         Node::setParent(parent);
@@ -75,6 +135,9 @@ namespace Ogre {
         {
             setInSceneGraph(false);
         }
+
+        if (mCreator)
+            mCreator->_notifySceneGraphLayoutChanged();
     }
     //-----------------------------------------------------------------------
     void SceneNode::setInSceneGraph(bool inGraph)
@@ -232,21 +295,73 @@ namespace Ogre {
         if (!cam->isVisible(mWorldAABB))
             return;
 
+        findVisibleObjectsImpl(cam, queue, visibleBounds, includeChildren, displayNodes, onlyShadowCasters);
+    }
+    //-----------------------------------------------------------------------
+    void SceneNode::findVisibleObjectsImpl(Camera* cam, RenderQueue* queue,
+        VisibleObjectsBoundsInfo* visibleBounds, bool includeChildren,
+        bool displayNodes, bool onlyShadowCasters)
+    {
         // Add all entities
         for (auto *o : mObjectsByName)
         {
             queue->processVisibleObject(o, cam, onlyShadowCasters, visibleBounds);
         }
 
-        if (includeChildren)
+        // below this, testing the children one by one is cheaper than gathering them
+        static const size_t MIN_BATCH_SIZE = 8;
+        static const size_t BATCH_SIZE = 32;
+
+        const auto& children = getChildren();
+        if (includeChildren && children.size() < MIN_BATCH_SIZE)
         {
-            for (auto child : getChildren())
+            for (auto child : children)
             {
                 SceneNode* sceneChild = static_cast<SceneNode*>(child);
                 sceneChild->_findVisibleObjects(cam, queue, visibleBounds, includeChildren, 
                     displayNodes, onlyShadowCasters);
             }
         }
+        else if (includeChildren)
+        {
+            // cull the children in batches, so the camera can test several boxes at once
+            Vector3 centres[BATCH_SIZE];
+            Vector3 halfSizes[BATCH_SIZE];
+            for (size_t first = 0; first < children.size(); first += BATCH_SIZE)
+            {
+                size_t count = std::min(BATCH_SIZE, children.size() - first);
+                uint32 infinite = 0, null = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const AxisAlignedBox& box = static_cast<SceneNode*>(children[first + i])->mWorldAABB;
+                    if (box.isFinite())
+                    {
+                        centres[i] = box.getCenter();
+                        halfSizes[i] = box.getHalfSize();
+                        continue;
+                    }
+                    centres[i] = halfSizes[i] = Vector3::ZERO;
+                    if (box.isNull())
+                        null |= 1u << i;
+                    else
+                        infinite |= 1u << i;
+                }
+
+                uint32 visible;
+                cam->isVisible(centres, halfSizes, count, &visible);
+                visible = (visible | infinite) & ~null;
+
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (visible & (1u << i))
+                    {
+                        static_cast<SceneNode*>(children[first + i])
+                            ->findVisibleObjectsImpl(cam, queue, visibleBounds, includeChildren, displayNodes,
+                                                     onlyShadowCasters);
+                    }
+                }
+            }
+        }
 
         if (mCreator && mCreator->getDebugDrawer())
         {
@@ -232,6 +232,20 @@ namespace Ogre {
         return mResult;
     }
     //-----------------------------------------------------------------------
+    void RaySceneQuery::execute(const std::vector<Ray>& rays, std::vector<RaySceneQueryResult>& results)
+    {
+        Ray ray = mRay;
+
+        results.resize(rays.size());
+        for (size_t i = 0; i < rays.size(); i++)
+        {
+            setRay(rays[i]);
+            results[i] = execute();
+        }
+
+        setRay(ray);
+    }
+    //-----------------------------------------------------------------------
     const RaySceneQueryResult& RaySceneQuery::getLastResults(void) const
     {
         return mResult;
@@ -1603,13 +1603,21 @@ namespace Ogre
     //-----------------------------------------------------------------------
     void ScriptCompilerManager::parseScript(DataStreamPtr& stream, const String& groupName)
     {
-        ConcreteNodeListPtr nodes =
-            ScriptParser::parse(ScriptLexer::tokenize(stream->getAsString(), stream->getName()), stream->getName());
-        {
-            // compile is not reentrant
-            OGRE_LOCK_AUTO_MUTEX;
-            mScriptCompiler.compile(nodes, groupName);
-        }
+        parsePreparedScript(prepareScript(stream), groupName);
+    }
+    //-----------------------------------------------------------------------
+    Any ScriptCompilerManager::prepareScript(DataStreamPtr& stream)
+    {
+        // tokenizing and parsing only depend on the script itself
+        return ScriptParser::parse(ScriptLexer::tokenize(stream->getAsString(), stream->getName()),
+                                   stream->getName());
+    }
+    //-----------------------------------------------------------------------
+    void ScriptCompilerManager::parsePreparedScript(const Any& prepared, const String& groupName)
+    {
+        // compile is not reentrant
+        OGRE_LOCK_AUTO_MUTEX;
+        mScriptCompiler.compile(any_cast<ConcreteNodeListPtr>(prepared), groupName);
     }
 
     //-------------------------------------------------------------------------
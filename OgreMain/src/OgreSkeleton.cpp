@@ -627,6 +627,14 @@ namespace Ogre {
         }
     }
     //---------------------------------------------------------------------
+    void Skeleton::compileAllAnimations(Real sampleRate, bool quantise)
+    {
+        for (auto& a : mAnimationsList)
+        {
+            a.second->compile(sampleRate, quantise);
+        }
+    }
+    //---------------------------------------------------------------------
     void Skeleton::addLinkedSkeletonAnimationSource(const String& skelName, 
         Real scale)
     {
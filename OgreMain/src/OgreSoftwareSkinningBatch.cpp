@@ -0,0 +1,87 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#include "OgreStableHeaders.h"
+#include "OgreSoftwareSkinningBatch.h"
+
+namespace Ogre
+{
+    // vertices blended by a single task, large enough to amortise the scheduling
+    static const size_t VERTICES_PER_RANGE = 2048;
+    //-----------------------------------------------------------------------
+    SoftwareSkinningBatch::SoftwareSkinningBatch() : mOpen(false) {}
+    //-----------------------------------------------------------------------
+    SoftwareSkinningBatch::~SoftwareSkinningBatch()
+    {
+        if (mOpen)
+            end(NULL);
+    }
+    //-----------------------------------------------------------------------
+    void SoftwareSkinningBatch::begin()
+    {
+        // a batch left open, e.g. by an exception, is flushed first
+        if (mOpen)
+            end(NULL);
+        mOpen = true;
+    }
+    //-----------------------------------------------------------------------
+    bool SoftwareSkinningBatch::add(const VertexData* sourceVertexData, const VertexData* targetVertexData,
+                                    const Affine3* const* blendMatrices, size_t numMatrices,
+                                    bool blendNormals)
+    {
+        if (!mOpen)
+            return false;
+
+        OGRE_WQ_LOCK_MUTEX(mMutex);
+        Blend b;
+        b.info = Mesh::prepareSoftwareVertexBlend(
+            sourceVertexData, targetVertexData, blendNormals,
+            [this](HardwareBuffer* buf, HardwareBuffer::LockOptions options)
+            {
+                void*& data = mLockedBuffers[buf];
+                if (!data)
+                    data = buf->lock(options);
+                return data;
+            });
+        b.firstMatrix = mMatrices.size();
+        mMatrices.insert(mMatrices.end(), blendMatrices, blendMatrices + numMatrices);
+        mBlends.push_back(b);
+        return true;
+    }
+    //-----------------------------------------------------------------------
+    void SoftwareSkinningBatch::end(WorkQueue* workQueue)
+    {
+        OgreProfileGroup("SoftwareSkinningBatch", OGREPROF_GENERAL);
+        mOpen = false;
+
+        mRanges.clear();
+        for (size_t i = 0; i < mBlends.size(); ++i)
+        {
+            size_t numVertices = mBlends[i].info.numVertices;
+            for (size_t start = 0; start < numVertices; start += VERTICES_PER_RANGE)
+                mRanges.push_back({i, start, std::min(VERTICES_PER_RANGE, numVertices - start)});
+        }
+
+        auto blendRange = [this](size_t i)
+        {
+            const Range& r = mRanges[i];
+            const Blend& b = mBlends[r.blend];
+            b.info.blend(mMatrices.data() + b.firstMatrix, r.start, r.count);
+        };
+        if (workQueue && mRanges.size() > 1)
+            workQueue->parallelFor(0, mRanges.size(), blendRange);
+        else
+        {
+            for (size_t i = 0; i < mRanges.size(); ++i)
+                blendRange(i);
+        }
+
+        for (auto& l : mLockedBuffers)
+            l.first->unlock();
+        mLockedBuffers.clear();
+        mBlends.clear();
+        mMatrices.clear();
+    }
+}
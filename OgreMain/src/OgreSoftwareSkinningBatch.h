@@ -0,0 +1,79 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#ifndef __SoftwareSkinningBatch_H__
+#define __SoftwareSkinningBatch_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreMesh.h"
+#include "OgreWorkQueue.h"
+
+namespace Ogre
+{
+/** \addtogroup Core
+ *  @{
+ */
+/** \addtogroup Animation
+ *  @{
+ */
+/** Collects the software vertex blends of a frame and runs them on the WorkQueue
+
+    While the batch is open, Mesh::softwareVertexBlend calls are queued instead of being
+    executed. The buffers are locked when a blend is queued, so source buffers shared by
+    several entities are locked only once. When the batch is closed, all queued vertices are
+    split into ranges of similar size, which are blended concurrently, and the buffers are
+    unlocked again.
+*/
+class SoftwareSkinningBatch : public AnimationAlloc
+{
+public:
+    SoftwareSkinningBatch();
+    ~SoftwareSkinningBatch();
+
+    /// start collecting blends
+    void begin();
+
+    /** Queues Mesh::softwareVertexBlend with the same arguments
+
+        The matrix pointers are copied, the matrices must stay valid until end.
+    @note may be called from several threads at once
+    @return false if the batch is not open, the blend must be done immediately then
+    */
+    bool add(const VertexData* sourceVertexData, const VertexData* targetVertexData,
+             const Affine3* const* blendMatrices, size_t numMatrices, bool blendNormals);
+
+    /// blend everything queued since begin and unlock the buffers
+    void end(WorkQueue* workQueue);
+
+    bool isOpen() const { return mOpen; }
+
+private:
+    struct Blend
+    {
+        Mesh::SoftwareVertexBlendInfo info;
+        /// offset of the matrices in mMatrices
+        size_t firstMatrix;
+    };
+
+    /// a range of the vertices of a Blend
+    struct Range
+    {
+        size_t blend;
+        size_t start;
+        size_t count;
+    };
+
+    std::vector<Blend> mBlends;
+    std::vector<const Affine3*> mMatrices;
+    std::vector<Range> mRanges;
+    std::unordered_map<HardwareBuffer*, void*> mLockedBuffers;
+    OGRE_WQ_MUTEX(mMutex);
+    bool mOpen;
+};
+/** @} */
+/** @} */
+} // namespace Ogre
+
+#endif
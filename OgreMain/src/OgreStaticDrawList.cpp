@@ -0,0 +1,78 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#include "OgreStableHeaders.h"
+#include "OgreStaticDrawList.h"
+
+namespace Ogre
+{
+StaticDrawList::StaticDrawList()
+    : mState(EMPTY), mCamera(NULL), mCameraPolygonMode(PM_SOLID), mLightsDirtyCounter(0), mGroupVersion(0),
+      mOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP)
+{
+}
+
+bool StaticDrawList::update(const RenderQueueGroup* group, QueuedRenderableCollection::OrganisationMode om,
+                            const Camera* cam, ulong lightsDirtyCounter)
+{
+    // same order as SceneManager::renderBasicQueueGroupObjects
+    mCollector.items.clear();
+    for (const auto& pg : group->getPriorityGroups())
+    {
+        pg.second->getSolidsBasic().acceptVisitor(&mCollector, om);
+        pg.second->getTransparentsUnsorted().acceptVisitor(&mCollector, om);
+        pg.second->getTransparents().acceptVisitor(&mCollector, QueuedRenderableCollection::OM_SORT_DESCENDING);
+    }
+
+    auto sameItem = [](const RenderablePass& a, const RenderablePass& b)
+    { return a.renderable == b.renderable && a.pass == b.pass; };
+
+    bool unchanged = mState != EMPTY && mCamera == cam && mCameraPolygonMode == cam->getPolygonMode() &&
+                     mLightsDirtyCounter == lightsDirtyCounter && mGroupVersion == group->_getStaticVersion() &&
+                     mOrganisationMode == om && mQueued.size() == mCollector.items.size() &&
+                     std::equal(mQueued.begin(), mQueued.end(), mCollector.items.begin(), sameItem);
+
+    if (unchanged && mState != RECORDING)
+        return mState == RECORDED;
+
+    mQueued.swap(mCollector.items);
+    mCamera = cam;
+    mCameraPolygonMode = cam->getPolygonMode();
+    mLightsDirtyCounter = lightsDirtyCounter;
+    mGroupVersion = group->_getStaticVersion();
+    mOrganisationMode = om;
+
+    mDraws.clear();
+    mLightLists.clear();
+    mState = RECORDING;
+    return false;
+}
+
+void StaticDrawList::addDraw(Renderable* rend, const Pass* pass, const LightList* lights, CullingMode cullingMode,
+                             PolygonMode polygonMode)
+{
+    // consecutive draws mostly use the same lights
+    static const LightList noLights;
+    const LightList& drawLights = lights ? *lights : noLights;
+    if (mLightLists.empty() || mLightLists.back() != drawLights)
+        mLightLists.push_back(drawLights);
+
+    Draw draw = {pass, rend, uint32(mLightLists.size() - 1), cullingMode, polygonMode};
+    mDraws.push_back(draw);
+}
+
+void StaticDrawList::abortRecording()
+{
+    mDraws.clear();
+    mLightLists.clear();
+    mState = FAILED;
+}
+
+void StaticDrawList::endRecording()
+{
+    if (mState == RECORDING)
+        mState = RECORDED;
+}
+} // namespace Ogre
@@ -0,0 +1,113 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#ifndef __StaticDrawList_H__
+#define __StaticDrawList_H__
+
+#include "OgrePrerequisites.h"
+#include "OgreRenderQueueSortingGrouping.h"
+
+namespace Ogre
+{
+/** \addtogroup Core
+ *  @{
+ */
+/** \addtogroup Scene
+ *  @{
+ */
+/** The draws issued for a static RenderQueueGroup
+
+    Records the state SceneManager::renderSingleObject derived for every draw of the group, i.e.
+    the pass, the lights and the culling and polygon modes, so the draws can be replayed without
+    visiting the queue and deriving the state again.
+
+    The recording stays valid as long as the same renderables are queued in the same order
+    and neither the camera, the lights affecting the frustum nor the static version of the
+    group changed. Render operations and world transforms are still taken from the renderables
+    on replay, so a renderable which was destroyed is never accessed through the recording.
+*/
+class StaticDrawList : public SceneMgtAlloc
+{
+public:
+    struct Draw
+    {
+        const Pass* pass;
+        Renderable* renderable;
+        /// index into getLightLists()
+        uint32 lights;
+        CullingMode cullingMode;
+        PolygonMode polygonMode;
+    };
+
+    StaticDrawList();
+
+    /** Check whether the recorded draws match the queued renderables
+
+        If not, the recording is discarded and a new one is started.
+        @return true if the recorded draws can be replayed
+    */
+    bool update(const RenderQueueGroup* group, QueuedRenderableCollection::OrganisationMode om,
+                const Camera* cam, ulong lightsDirtyCounter);
+
+    /// Whether draws should be recorded, i.e. update returned false and nothing aborted the recording
+    bool isRecording() const { return mState == RECORDING; }
+
+    /// Record a draw with the state that is set up for it
+    void addDraw(Renderable* rend, const Pass* pass, const LightList* lights, CullingMode cullingMode,
+                 PolygonMode polygonMode);
+
+    /** Discard the recording, as the group issued a draw which can not be replayed
+
+        The draws are not recorded again, until the queued renderables change.
+    */
+    void abortRecording();
+
+    /// Finish the recording after the group was rendered
+    void endRecording();
+
+    const std::vector<Draw>& getDraws() const { return mDraws; }
+    const std::vector<LightList>& getLightLists() const { return mLightLists; }
+
+private:
+    enum State
+    {
+        EMPTY,
+        RECORDING,
+        RECORDED,
+        FAILED
+    };
+
+    /// collects the queued renderables in the order SceneManager renders them
+    struct QueueCollector : public QueuedRenderableVisitor
+    {
+        std::vector<RenderablePass> items;
+
+        void visit(RenderablePass* rp) override { items.push_back(*rp); }
+        void visit(const Pass* p, RenderableList& rs) override
+        {
+            for (auto* r : rs)
+                items.push_back(RenderablePass(r, const_cast<Pass*>(p)));
+        }
+    };
+
+    State mState;
+    std::vector<Draw> mDraws;
+    std::vector<LightList> mLightLists;
+
+    /// the queue contents and state the draws were recorded for
+    std::vector<RenderablePass> mQueued;
+    const Camera* mCamera;
+    PolygonMode mCameraPolygonMode;
+    ulong mLightsDirtyCounter;
+    uint32 mGroupVersion;
+    QueuedRenderableCollection::OrganisationMode mOrganisationMode;
+
+    QueueCollector mCollector;
+};
+/** @} */
+/** @} */
+} // namespace Ogre
+
+#endif
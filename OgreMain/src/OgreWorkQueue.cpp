@@ -30,6 +30,32 @@ THE SOFTWARE.
 #include "OgreTimer.h"
 
 namespace Ogre {
+    namespace
+    {
+    /// the work queue and task queue the calling thread is the worker for
+    struct WorkerBinding
+    {
+        const DefaultWorkQueueBase* queue;
+        size_t index;
+    };
+    thread_local WorkerBinding tlsWorkerBinding = {NULL, 0};
+    } // namespace
+
+    struct DefaultWorkQueueBase::TaskQueue
+    {
+        /// only held to add or take a single task
+        OGRE_WQ_MUTEX(mutex);
+        std::deque<std::function<void()>> tasks[TP_COUNT];
+        /// sizes of tasks, so other threads can skip empty queues without locking
+        std::atomic<size_t> counts[TP_COUNT];
+
+        TaskQueue()
+        {
+            for (auto& c : counts)
+                c = 0;
+        }
+    };
+    //---------------------------------------------------------------------
     void WorkQueue::processMainThreadTasks()
     {
         OGRE_IGNORE_DEPRECATED_BEGIN
@@ -37,6 +63,79 @@ namespace Ogre {
         OGRE_IGNORE_DEPRECATED_END
     }
     //---------------------------------------------------------------------
+    void WorkQueue::parallelFor(size_t begin, size_t end, const std::function<void(size_t)>& func,
+                                size_t grainSize)
+    {
+        if (begin >= end)
+            return;
+
+        grainSize = std::max<size_t>(grainSize, 1);
+        size_t numChunks = (end - begin + grainSize - 1) / grainSize;
+
+        // the calling thread processes one share itself
+        size_t numTasks = std::min(getWorkerThreadCount(), numChunks - 1);
+#if OGRE_THREAD_SUPPORT
+        if (isPaused() || !getRequestsAccepted())
+            numTasks = 0;
+#else
+        numTasks = 0;
+#endif
+
+        if (numTasks == 0)
+        {
+            for (size_t i = begin; i < end; ++i)
+                func(i);
+            return;
+        }
+
+#if OGRE_THREAD_SUPPORT
+        // shared with the tasks, as these might only get to run after we returned
+        struct SharedRange
+        {
+            std::atomic<size_t> next;
+            std::atomic<size_t> pendingChunks;
+            size_t end;
+            size_t grainSize;
+            const std::function<void(size_t)>* func;
+            OGRE_WQ_MUTEX(mutex);
+            OGRE_WQ_THREAD_SYNCHRONISER(finished);
+        };
+        auto range = std::make_shared<SharedRange>();
+        range->next = begin;
+        range->pendingChunks = numChunks;
+        range->end = end;
+        range->grainSize = grainSize;
+        range->func = &func;
+
+        auto processChunks = [range]()
+        {
+            size_t first;
+            // func is only touched while chunks are pending, so the caller is still waiting
+            while ((first = range->next.fetch_add(range->grainSize)) < range->end)
+            {
+                size_t last = std::min(first + range->grainSize, range->end);
+                for (size_t i = first; i < last; ++i)
+                    (*range->func)(i);
+
+                if (range->pendingChunks.fetch_sub(1) == 1)
+                {
+                    OGRE_WQ_LOCK_MUTEX(range->mutex);
+                    OGRE_THREAD_NOTIFY_ALL(range->finished);
+                }
+            }
+        };
+
+        for (size_t i = 0; i < numTasks; ++i)
+            addTask(processChunks, TP_HIGH);
+
+        processChunks();
+
+        OGRE_WQ_LOCK_MUTEX_NAMED(range->mutex, lock);
+        while (range->pendingChunks > 0)
+            OGRE_THREAD_WAIT(range->finished, range->mutex, lock);
+#endif
+    }
+    //---------------------------------------------------------------------
     WorkQueue::Request::Request(uint16 channel, uint16 rtype, const Any& rData, uint8 retry, RequestID rid)
         : mChannel(channel), mType(rtype), mData(rData), mRetryCount(retry), mID(rid), mAborted(false)
     {
@@ -67,10 +166,14 @@ namespace Ogre {
         , mWorkerRenderSystemAccess(false)
         , mIsRunning(false)
         , mResposeTimeLimitMS(10)
+        , mNumPendingTasks(0)
+        , mNumWaitingWorkers(0)
+        , mNextTaskQueue(0)
         , mPaused(false)
         , mAcceptRequests(true)
         , mShuttingDown(false)
     {
+        createTaskQueues(1);
     }
     //---------------------------------------------------------------------
     const String& DefaultWorkQueueBase::getName() const
@@ -100,20 +203,80 @@ namespace Ogre {
         mMainThreadTasks.push_back(task);
     }
     //---------------------------------------------------------------------
-    void DefaultWorkQueueBase::addTask(std::function<void()> task)
+    void DefaultWorkQueueBase::createTaskQueues(size_t count)
+    {
+        std::vector<std::unique_ptr<TaskQueue>> queues;
+        for (size_t i = 0; i < std::max<size_t>(count, 1); ++i)
+            queues.emplace_back(new TaskQueue());
+
+        // hand the queued tasks over in order
+        for (auto& q : mTaskQueues)
+        {
+            for (int p = 0; p < TP_COUNT; ++p)
+            {
+                for (auto& task : q->tasks[p])
+                    queues[0]->tasks[p].push_back(std::move(task));
+                queues[0]->counts[p] = queues[0]->tasks[p].size();
+            }
+        }
+
+        mTaskQueues.swap(queues);
+        mNextTaskQueue = 0;
+    }
+    //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::bindThreadToTaskQueue(size_t index)
+    {
+        tlsWorkerBinding.queue = this;
+        tlsWorkerBinding.index = index % mTaskQueues.size();
+    }
+    //---------------------------------------------------------------------
+    void DefaultWorkQueueBase::addTask(std::function<void()> task, TaskPriority priority)
     {
-        OGRE_WQ_LOCK_MUTEX(mRequestMutex);
         if (!mAcceptRequests || mShuttingDown)
             return;
 
 #if OGRE_THREAD_SUPPORT
-        mTasks.push_back(task);
+        // workers keep their own tasks, the ones of other threads are spread over all workers
+        size_t index = tlsWorkerBinding.queue == this ? tlsWorkerBinding.index
+                                                      : mNextTaskQueue++ % mTaskQueues.size();
+        TaskQueue& queue = *mTaskQueues[index];
+        {
+            OGRE_WQ_LOCK_MUTEX(queue.mutex);
+            queue.tasks[priority].push_back(std::move(task));
+            ++queue.counts[priority];
+        }
+        ++mNumPendingTasks;
         notifyWorkers();
 #else
         task(); // no threading, just run it
 #endif
-        LogManager::getSingleton().stream(LML_TRIVIAL)
-            << "DefaultWorkQueueBase('" << mName << "') - QUEUED(thread:" << OGRE_THREAD_CURRENT_ID << ")";
+    }
+    //---------------------------------------------------------------------
+    bool DefaultWorkQueueBase::takeTask(std::function<void()>& task)
+    {
+        size_t numQueues = mTaskQueues.size();
+        size_t first = tlsWorkerBinding.queue == this ? tlsWorkerBinding.index : mNextTaskQueue % numQueues;
+
+        for (int p = TP_COUNT - 1; p >= 0 && mNumPendingTasks > 0; --p)
+        {
+            // own queue first, then steal from the others
+            for (size_t i = 0; i < numQueues; ++i)
+            {
+                TaskQueue& queue = *mTaskQueues[(first + i) % numQueues];
+                if (queue.counts[p] == 0)
+                    continue;
+
+                OGRE_WQ_LOCK_MUTEX(queue.mutex);
+                if (queue.tasks[p].empty())
+                    continue;
+                task = std::move(queue.tasks[p].front());
+                queue.tasks[p].pop_front();
+                --queue.counts[p];
+                --mNumPendingTasks;
+                return true;
+            }
+        }
+        return false;
     }
     //---------------------------------------------------------------------
     void DefaultWorkQueueBase::setPaused(bool pause)
@@ -143,18 +306,8 @@ namespace Ogre {
     void DefaultWorkQueueBase::_processNextRequest()
     {
         std::function<void()> task;
-        {
-            // scoped to only lock while retrieving the next request
-            OGRE_WQ_LOCK_MUTEX(mRequestMutex);
-            if (mTasks.empty())
-                return;
-            LogManager::getSingleton().stream(LML_TRIVIAL)
-                << "DefaultWorkQueueBase('" << mName << "') - PROCESS_TASK(thread:" << OGRE_THREAD_CURRENT_ID
-                << ")";
-            task = std::move(mTasks.front());
-            mTasks.pop_front();
-        }
-        task();
+        if (takeTask(task))
+            task();
     }
     //---------------------------------------------------------------------
     void DefaultWorkQueueBase::processMainThreadTasks()
@@ -163,25 +316,40 @@ namespace Ogre {
         unsigned long msCurrent = 0;
 
         // keep going until we run out of responses or out of time
-        while(!mMainThreadTasks.empty())
+        std::deque<std::function<void()>> tasks;
+        while (true)
         {
-            std::function<void()> task;
+            // take all tasks at once, so the workers adding more are not blocked meanwhile
             {
                 OGRE_WQ_LOCK_MUTEX(mResponseMutex);
-                LogManager::getSingleton().stream(LML_TRIVIAL)
-                    << "DefaultWorkQueueBase('" << mName << "') - PROCESS_MAIN_TASK";
-                task = std::move(mMainThreadTasks.front());
-                mMainThreadTasks.pop_front();
+                tasks.swap(mMainThreadTasks);
             }
-            task();
+            if (tasks.empty())
+                return;
 
-            // time limit
-            if (mResposeTimeLimitMS)
+            while (!tasks.empty())
             {
-                msCurrent = Root::getSingleton().getTimer()->getMilliseconds();
-                if (msCurrent - msStart > mResposeTimeLimitMS)
-                    break;
+                std::function<void()> task = std::move(tasks.front());
+                tasks.pop_front();
+                task();
+
+                // time limit
+                if (mResposeTimeLimitMS)
+                {
+                    msCurrent = Root::getSingleton().getTimer()->getMilliseconds();
+                    if (msCurrent - msStart > mResposeTimeLimitMS)
+                        break;
+                }
             }
+
+            if (!tasks.empty())
+                break;
         }
+
+        // keep the remaining tasks ahead of the ones added meanwhile
+        OGRE_WQ_LOCK_MUTEX(mResponseMutex);
+        for (auto& task : mMainThreadTasks)
+            tasks.push_back(std::move(task));
+        mMainThreadTasks.swap(tasks);
     }
 }
@@ -29,18 +29,58 @@ THE SOFTWARE.
 
 #if OGRE_NO_ZIP_ARCHIVE == 0
 #include <zip.h>
+#define MINIZ_HEADER_FILE_ONLY
+#include <miniz.h>
 
 namespace Ogre {
 namespace {
+    bool gUseMemoryMapping = false;
+
+    /// Stored entry of a memory mapped archive, referencing the archive memory
+    class ZipEntryView : public MemoryDataStream
+    {
+        MemoryDataStreamPtr mArchiveBuffer;
+    public:
+        ZipEntryView(const String& name, uchar* data, size_t size, const MemoryDataStreamPtr& archiveBuffer)
+            : MemoryDataStream(name, data, size, false, true), mArchiveBuffer(archiveBuffer)
+        {
+        }
+    };
+
     class ZipArchive : public Archive
     {
     protected:
-        /// Handle to root zip file
+        /// An entry of the central directory
+        struct ZipEntry
+        {
+            /// Offset of the local file header
+            uint64 headerOffset;
+            uint64 compressedSize;
+            uint64 uncompressedSize;
+            uint16 method;
+            uint16 flags;
+        };
+
+        /// Handle to root zip file, owned by mReaders after loading
         zip_t* mZipFile;
+        /// Reader contexts currently not used by open, as zip_t has cursor state
+        mutable std::vector<zip_t*> mReaders;
+        OGRE_WQ_MUTEX(mReadersMutex);
         MemoryDataStreamPtr mBuffer;
         /// File list (since zziplib seems to only allow scanning of dir tree once)
         FileInfoList mFileList;
+        /// Whether the archive is memory mapped and indexed lazily, instead of using mZipFile
+        bool mLazy;
+        /// Entries of the central directory, if lazily indexed
+        std::unordered_map<String, ZipEntry> mIndex;
+        bool mIndexed;
         OGRE_AUTO_MUTEX;
+
+        void addFileInfo(String name, size_t compressedSize, size_t uncompressedSize, bool isDir);
+        void readCentralDirectory();
+        DataStreamPtr openIndexed(const String& filename) const;
+        zip_t* acquireReader() const;
+        void releaseReader(zip_t* reader) const;
     public:
         ZipArchive(const String& name, const String& archType, const uint8* externBuf = 0, size_t externBufSz = 0);
         ~ZipArchive();
@@ -84,7 +124,7 @@ namespace {
 }
     //-----------------------------------------------------------------------
     ZipArchive::ZipArchive(const String& name, const String& archType, const uint8* externBuf, size_t externBufSz)
-        : Archive(name, archType), mZipFile(0)
+        : Archive(name, archType), mZipFile(0), mLazy(gUseMemoryMapping), mIndexed(false)
     {
         if(externBuf)
             mBuffer.reset(new MemoryDataStream(const_cast<uint8*>(externBuf), externBufSz));
@@ -98,6 +138,18 @@ namespace {
     void ZipArchive::load()
     {
         OGRE_LOCK_AUTO_MUTEX;
+        if (mLazy)
+        {
+            if (!mIndexed)
+            {
+                if (!mBuffer)
+                    mBuffer = std::make_shared<MmapDataStream>(mName);
+                readCentralDirectory();
+                mIndexed = true;
+            }
+            return;
+        }
+
         if (!mZipFile)
         {
             if(!mBuffer)
@@ -108,36 +160,153 @@ namespace {
             // Cache names
             int n = zip_entries_total(mZipFile);
             for (int i = 0; i < n; ++i) {
-                FileInfo info;
-                info.archive = this;
-
                 zip_entry_openbyindex(mZipFile, i);
+                addFileInfo(zip_entry_name(mZipFile), zip_entry_comp_size(mZipFile), zip_entry_size(mZipFile),
+                            zip_entry_isdir(mZipFile));
+                zip_entry_close(mZipFile);
+            }
+            mReaders.push_back(mZipFile);
+        }
+    }
+    //-----------------------------------------------------------------------
+    void ZipArchive::addFileInfo(String name, size_t compressedSize, size_t uncompressedSize, bool isDir)
+    {
+        FileInfo info;
+        info.archive = this;
 
-                info.filename = zip_entry_name(mZipFile);
-                // Get basename / path
-                StringUtil::splitFilename(info.filename, info.basename, info.path);
+        info.filename = name;
+        // Get basename / path
+        StringUtil::splitFilename(info.filename, info.basename, info.path);
 
-                // Get sizes
-                info.uncompressedSize = zip_entry_size(mZipFile);
-                info.compressedSize = zip_entry_comp_size(mZipFile);
+        // Get sizes
+        info.uncompressedSize = uncompressedSize;
+        info.compressedSize = compressedSize;
 
-                if (zip_entry_isdir(mZipFile))
-                {
-                    info.filename = info.filename.substr(0, info.filename.length() - 1);
-                    StringUtil::splitFilename(info.filename, info.basename, info.path);
-                    // Set compressed size to -1 for folders; anyway nobody will check
-                    // the compressed size of a folder, and if he does, its useless anyway
-                    info.compressedSize = size_t(-1);
-                }
+        if (isDir)
+        {
+            info.filename = info.filename.substr(0, info.filename.length() - 1);
+            StringUtil::splitFilename(info.filename, info.basename, info.path);
+            // Set compressed size to -1 for folders; anyway nobody will check
+            // the compressed size of a folder, and if he does, its useless anyway
+            info.compressedSize = size_t(-1);
+        }
 #if !OGRE_RESOURCEMANAGER_STRICT
-                else
+        else
+        {
+            info.filename = info.basename;
+        }
+#endif
+        mFileList.push_back(info);
+    }
+    //-----------------------------------------------------------------------
+    template <typename T> static T readLE(const uchar* p)
+    {
+        T val;
+        memcpy(&val, p, sizeof(T));
+#if OGRE_ENDIAN == OGRE_ENDIAN_BIG
+        Bitwise::bswapBuffer(&val, sizeof(T));
+#endif
+        return val;
+    }
+    /// key of mIndex, zip_entry_open only ignores the case if not strict
+    static String indexKey(const String& name)
+    {
+#if OGRE_RESOURCEMANAGER_STRICT
+        return name;
+#else
+        String key = name;
+        StringUtil::toLowerCase(key);
+        return key;
+#endif
+    }
+    //-----------------------------------------------------------------------
+    void ZipArchive::readCentralDirectory()
+    {
+        const uchar* data = mBuffer->getPtr();
+        size_t size = mBuffer->size();
+
+        // find the end of central directory record, which is followed by a comment of up to 64k
+        const size_t EOCD_SIZE = 22;
+        if (size < EOCD_SIZE)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "not a zip archive: " + mName);
+        size_t eocd = size - EOCD_SIZE;
+        size_t minEocd = eocd > 0xFFFF ? eocd - 0xFFFF : 0;
+        while (readLE<uint32>(data + eocd) != 0x06054b50)
+        {
+            if (eocd == minEocd)
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "not a zip archive: " + mName);
+            eocd--;
+        }
+
+        uint64 numEntries = readLE<uint16>(data + eocd + 10);
+        uint64 dirSize = readLE<uint32>(data + eocd + 12);
+        uint64 dirOffset = readLE<uint32>(data + eocd + 16);
+
+        // zip64 end of central directory locator, for archives larger than 4GB
+        if (eocd >= 20 && readLE<uint32>(data + eocd - 20) == 0x07064b50)
+        {
+            uint64 eocd64 = readLE<uint64>(data + eocd - 20 + 8);
+            if (eocd64 + 56 > size || readLE<uint32>(data + eocd64) != 0x06064b50)
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "corrupt zip64 archive: " + mName);
+            numEntries = readLE<uint64>(data + eocd64 + 32);
+            dirSize = readLE<uint64>(data + eocd64 + 40);
+            dirOffset = readLE<uint64>(data + eocd64 + 48);
+        }
+
+        if (dirOffset + dirSize > size)
+            OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "corrupt zip archive: " + mName);
+
+        const uchar* p = data + dirOffset;
+        const uchar* end = p + dirSize;
+        mIndex.reserve(numEntries);
+        for (uint64 i = 0; i < numEntries; i++)
+        {
+            if (p + 46 > end || readLE<uint32>(p) != 0x02014b50)
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "corrupt zip archive: " + mName);
+
+            ZipEntry entry;
+            entry.flags = readLE<uint16>(p + 8);
+            entry.method = readLE<uint16>(p + 10);
+            entry.compressedSize = readLE<uint32>(p + 20);
+            entry.uncompressedSize = readLE<uint32>(p + 24);
+            entry.headerOffset = readLE<uint32>(p + 42);
+
+            uint16 nameLen = readLE<uint16>(p + 28);
+            uint16 extraLen = readLE<uint16>(p + 30);
+            uint16 commentLen = readLE<uint16>(p + 32);
+            if (p + 46 + nameLen + extraLen + commentLen > end)
+                OGRE_EXCEPT(Exception::ERR_INVALIDPARAMS, "corrupt zip archive: " + mName);
+
+            String name((const char*)p + 46, nameLen);
+
+            // the zip64 extended information holds the values, which do not fit into 32 bit
+            const uchar* extra = p + 46 + nameLen;
+            const uchar* extraEnd = extra + extraLen;
+            while (extra + 4 <= extraEnd)
+            {
+                uint16 id = readLE<uint16>(extra);
+                uint16 len = readLE<uint16>(extra + 2);
+                const uchar* field = extra + 4;
+                const uchar* fieldEnd = std::min(field + len, extraEnd);
+                if (id == 0x0001)
                 {
-                    info.filename = info.basename;
+                    for (uint64* val : {&entry.uncompressedSize, &entry.compressedSize, &entry.headerOffset})
+                    {
+                        if (*val != 0xFFFFFFFF || field + 8 > fieldEnd)
+                            continue;
+                        *val = readLE<uint64>(field);
+                        field += 8;
+                    }
                 }
-#endif
-                zip_entry_close(mZipFile);
-                mFileList.push_back(info);
+                extra += 4 + len;
             }
+
+            bool isDir = !name.empty() && name.back() == '/';
+            addFileInfo(name, entry.compressedSize, entry.uncompressedSize, isDir);
+            if (!isDir)
+                mIndex.emplace(indexKey(name), entry);
+
+            p += 46 + nameLen + extraLen + commentLen;
         }
     }
     //-----------------------------------------------------------------------
@@ -146,21 +315,43 @@ namespace {
         OGRE_LOCK_AUTO_MUTEX;
         if (mZipFile)
         {
-            zip_close(mZipFile);
+            OGRE_WQ_LOCK_MUTEX(mReadersMutex);
+            for (auto reader : mReaders)
+                zip_close(reader);
+            mReaders.clear();
             mZipFile = 0;
             mFileList.clear();
             mBuffer.reset();
         }
-    
+
+        if (mIndexed)
+        {
+            mIndexed = false;
+            mIndex.clear();
+            mFileList.clear();
+            mBuffer.reset();
+        }
     }
     //-----------------------------------------------------------------------
     DataStreamPtr ZipArchive::open(const String& filename, bool readOnly) const
     {
-        // zip is not threadsafe
-        OGRE_LOCK_AUTO_MUTEX;
+        if (mLazy)
+            return openIndexed(filename);
+
+        // zip is not threadsafe, so every open uses its own reader
+        struct ReaderGuard
+        {
+            const ZipArchive* archive;
+            zip_t* zip;
+            ~ReaderGuard()
+            {
+                zip_entry_close(zip);
+                archive->releaseReader(zip);
+            }
+        } reader = {this, acquireReader()};
         String lookUpFileName = filename;
 
-        bool open = zip_entry_open(mZipFile, lookUpFileName.c_str(), OGRE_RESOURCEMANAGER_STRICT) == 0;
+        bool open = zip_entry_open(reader.zip, lookUpFileName.c_str(), OGRE_RESOURCEMANAGER_STRICT) == 0;
 #if !OGRE_RESOURCEMANAGER_STRICT
         if (!open) // Try if we find the file
         {
@@ -171,7 +362,7 @@ namespace {
             {
                 Ogre::FileInfo info = fileNfo->at(0);
                 lookUpFileName = info.path + info.basename;
-                open = zip_entry_open(mZipFile, lookUpFileName.c_str(), OGRE_RESOURCEMANAGER_STRICT) == 0;
+                open = zip_entry_open(reader.zip, lookUpFileName.c_str(), OGRE_RESOURCEMANAGER_STRICT) == 0;
             }
         }
 #endif
@@ -182,11 +373,95 @@ namespace {
         }
 
         // Construct & return stream
-        auto ret = std::make_shared<MemoryDataStream>(lookUpFileName, zip_entry_size(mZipFile));
+        auto ret = std::make_shared<MemoryDataStream>(lookUpFileName, zip_entry_size(reader.zip));
 
-        if(zip_entry_noallocread(mZipFile, ret->getPtr(), ret->size()) < 0)
+        if(zip_entry_noallocread(reader.zip, ret->getPtr(), ret->size()) < 0)
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "could not read "+lookUpFileName);
+
+        return ret;
+    }
+    //-----------------------------------------------------------------------
+    zip_t* ZipArchive::acquireReader() const
+    {
+        {
+            OGRE_WQ_LOCK_MUTEX(mReadersMutex);
+            if (!mReaders.empty())
+            {
+                zip_t* reader = mReaders.back();
+                mReaders.pop_back();
+                return reader;
+            }
+        }
+
+        // all readers are in use by other threads, so add one sharing the archive memory
+        zip_t* reader = zip_stream_open((const char*)mBuffer->getPtr(), mBuffer->size(), 0, 'r');
+        if (!reader)
+            OGRE_EXCEPT(Exception::ERR_INTERNAL_ERROR, "could not read "+mName);
+        return reader;
+    }
+    //-----------------------------------------------------------------------
+    void ZipArchive::releaseReader(zip_t* reader) const
+    {
+        OGRE_WQ_LOCK_MUTEX(mReadersMutex);
+        mReaders.push_back(reader);
+    }
+    //-----------------------------------------------------------------------
+    DataStreamPtr ZipArchive::openIndexed(const String& filename) const
+    {
+        // the index is immutable after load, so no locking is needed
+        String lookUpFileName = filename;
+        auto it = mIndex.find(indexKey(lookUpFileName));
+#if !OGRE_RESOURCEMANAGER_STRICT
+        if (it == mIndex.end()) // Try if we find the file
+        {
+            String basename, path;
+            StringUtil::splitFilename(lookUpFileName, basename, path);
+            const FileInfoListPtr fileNfo = findFileInfo(basename, true);
+            if (fileNfo->size() == 1) // If there are more files with the same do not open anyone
+            {
+                Ogre::FileInfo info = fileNfo->at(0);
+                lookUpFileName = info.path + info.basename;
+                it = mIndex.find(indexKey(lookUpFileName));
+            }
+        }
+#endif
+
+        if (it == mIndex.end())
+        {
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "could not open "+lookUpFileName);
+        }
+
+        const ZipEntry& entry = it->second;
+        uchar* data = mBuffer->getPtr();
+        size_t size = mBuffer->size();
+
+        // the data follows the local file header, whose extra field may differ from the central directory
+        if (entry.headerOffset + 30 > size || readLE<uint32>(data + entry.headerOffset) != 0x04034b50)
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "could not read "+lookUpFileName);
+        const uchar* header = data + entry.headerOffset;
+        uint64 offset = entry.headerOffset + 30 + readLE<uint16>(header + 26) + readLE<uint16>(header + 28);
+        if (offset + entry.compressedSize > size)
+            OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "could not read "+lookUpFileName);
+
+        if (entry.flags & 1)
+            OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "encrypted entries are not supported: "+lookUpFileName);
+
+        if (entry.method == 0)
+        {
+            // stored, so return a view of the archive
+            return std::make_shared<ZipEntryView>(lookUpFileName, data + offset, size_t(entry.compressedSize),
+                                                  mBuffer);
+        }
+
+        if (entry.method != MZ_DEFLATED)
+            OGRE_EXCEPT(Exception::ERR_NOT_IMPLEMENTED, "unsupported compression method: "+lookUpFileName);
+
+        auto ret = std::make_shared<MemoryDataStream>(lookUpFileName, size_t(entry.uncompressedSize));
+        size_t read = tinfl_decompress_mem_to_mem(ret->getPtr(), ret->size(), data + offset,
+                                                  size_t(entry.compressedSize),
+                                                  TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF);
+        if (read != ret->size())
             OGRE_EXCEPT(Exception::ERR_FILE_NOT_FOUND, "could not read "+lookUpFileName);
-        zip_entry_close(mZipFile);
 
         return ret;
     }
@@ -316,6 +591,16 @@ namespace {
         return name;
     }
     //-----------------------------------------------------------------------
+    void ZipArchiveFactory::setUseMemoryMapping(bool useMapping)
+    {
+        gUseMemoryMapping = useMapping;
+    }
+    //-----------------------------------------------------------------------
+    bool ZipArchiveFactory::getUseMemoryMapping()
+    {
+        return gUseMemoryMapping;
+    }
+    //-----------------------------------------------------------------------
     //-----------------------------------------------------------------------
     //  EmbeddedZipArchiveFactory
     //-----------------------------------------------------------------------
@@ -176,6 +176,10 @@ namespace Ogre {
         SceneNode * createSceneNodeImpl ( void ) override;
         /** Creates a specialized BspSceneNode */
         SceneNode * createSceneNodeImpl ( const String &name ) override;
+        /** Not supported, as movables are moved between BSP leaves while updating */
+        void setParallelSceneGraphUpdate( bool enabled ) override {}
+        /** Not supported, as BspSceneNode customises the update */
+        void setNodeTransformStoreEnabled( bool enabled ) override {}
 
         /** Internal method for tagging BspNodes with objects which intersect them. */
         void _notifyObjectMoved(const MovableObject* mov, const Vector3& pos);
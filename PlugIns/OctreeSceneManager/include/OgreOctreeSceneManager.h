@@ -102,6 +102,8 @@ public:
 
     /** Does nothing more */
     void _updateSceneGraph( Camera * cam ) override;
+    /** Not supported, as nodes are moved within the octree while updating */
+    void setParallelSceneGraphUpdate( bool enabled ) override {}
     /** Recurses through the octree determining which nodes are visible. */
     void _findVisibleObjects ( Camera * cam,
         VisibleObjectsBoundsInfo* visibleBounds, bool onlyShadowCasters ) override;
@@ -185,6 +187,14 @@ protected:
 
     Octree::NodeList mVisible;
 
+    /// Tests the bounds of all nodes against the camera at once, the result is in mCullResults
+    void cullNodes( OctreeCamera *camera, const Octree::NodeList &nodes );
+
+    /// Scratch space for culling the nodes of a partially visible octant in one batch
+    std::vector<Vector3> mCullCentres;
+    std::vector<Vector3> mCullHalfSizes;
+    std::vector<uint32> mCullResults;
+
     /// The root octree
     Octree *mOctree;
 
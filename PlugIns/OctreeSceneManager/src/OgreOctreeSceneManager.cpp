@@ -595,15 +595,18 @@ void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue,
 
         bool vis = true;
 
-        while ( it != octant -> mNodes.end() )
+        // if this octree is partially visible, manually cull all
+        // scene nodes attached directly to this level.
+        // The scratch space is free again before we recurse into the children.
+        if ( v == OctreeCamera::PARTIAL )
+            cullNodes( camera, octant -> mNodes );
+
+        for ( size_t i = 0; it != octant -> mNodes.end(); ++i )
         {
             OctreeNode * sn = *it;
 
-            // if this octree is partially visible, manually cull all
-            // scene nodes attached directly to this level.
-
             if ( v == OctreeCamera::PARTIAL )
-                vis = camera -> isVisible( sn -> _getWorldAABB() );
+                vis = ( mCullResults[ i / 32 ] & ( 1u << ( i % 32 ) ) ) != 0;
 
             if ( vis )
             {
@@ -650,6 +653,43 @@ void OctreeSceneManager::walkOctree( OctreeCamera *camera, RenderQueue *queue,
 
 }
 
+void OctreeSceneManager::cullNodes( OctreeCamera *camera, const Octree::NodeList &nodes )
+{
+    size_t count = nodes.size();
+    mCullCentres.resize( count );
+    mCullHalfSizes.resize( count );
+    mCullResults.resize( ( count + 31 ) / 32 );
+
+    for ( size_t i = 0; i < count; ++i )
+    {
+        const AxisAlignedBox &box = nodes[ i ] -> _getWorldAABB();
+        if ( box.isFinite() )
+        {
+            mCullCentres[ i ] = box.getCenter();
+            mCullHalfSizes[ i ] = box.getHalfSize();
+        }
+        else
+        {
+            mCullCentres[ i ] = mCullHalfSizes[ i ] = Vector3::ZERO;
+        }
+    }
+
+    camera -> isVisible( mCullCentres.data(), mCullHalfSizes.data(), count, mCullResults.data() );
+
+    // null boxes are never visible, infinite ones always
+    for ( size_t i = 0; i < count; ++i )
+    {
+        const AxisAlignedBox &box = nodes[ i ] -> _getWorldAABB();
+        if ( box.isFinite() )
+            continue;
+        uint32 bit = 1u << ( i % 32 );
+        if ( box.isNull() )
+            mCullResults[ i / 32 ] &= ~bit;
+        else
+            mCullResults[ i / 32 ] |= bit;
+    }
+}
+
 // --- non template versions
 static void _findNodes( const AxisAlignedBox &t, std::list< SceneNode * > &list, SceneNode *exclude, bool full, Octree *octant )
 {
@@ -70,6 +70,10 @@ namespace Ogre
         /* Overridden isVisible function for aabb */
         bool isVisible( const AxisAlignedBox &bound, FrustumPlane *culledBy=0) const override;
 
+        /* Overridden batch isVisible function for aabbs */
+        void isVisible(const Vector3* centres, const Vector3* halfSizes, size_t count,
+                       uint32* visibility) const override;
+
         /* isVisible() function for portals */
         bool isVisible(PortalBase* portal, FrustumPlane* culledBy = 0) const;
 
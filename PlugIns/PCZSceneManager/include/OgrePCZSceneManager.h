@@ -136,6 +136,10 @@ namespace Ogre
 
         /** Update Scene Graph (does several things now) */
         void _updateSceneGraph( Camera * cam ) override;
+        /** Not supported, as nodes are moved between zones while updating */
+        void setParallelSceneGraphUpdate( bool enabled ) override {}
+        /** Not supported, as PCZSceneNode customises the update */
+        void setNodeTransformStoreEnabled( bool enabled ) override {}
 
         /** Recurses through the PCZTree determining which nodes are visible. */
         void _findVisibleObjects ( Camera * cam,
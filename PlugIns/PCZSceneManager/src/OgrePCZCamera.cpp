@@ -85,6 +85,24 @@ namespace Ogre
         return true;
    }
 
+    // this version checks the boxes passing the regular planes against the extra culling planes
+    void PCZCamera::isVisible(const Vector3* centres, const Vector3* halfSizes, size_t count,
+                              uint32* visibility) const
+    {
+        Camera::isVisible(centres, halfSizes, count, visibility);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32 bit = 1u << (i % 32);
+            if (!(visibility[i / 32] & bit))
+                continue;
+
+            AxisAlignedBox bound(centres[i] - halfSizes[i], centres[i] + halfSizes[i]);
+            if (!mExtraCullingFrustum.isVisible(bound))
+                visibility[i / 32] &= ~bit;
+        }
+    }
+
     /* A 'more detailed' check for visibility of an AAB.  This function returns
       none, partial, or full for visibility of the box.  This is useful for 
       stuff like Octree leaf culling */
@@ -40,9 +40,19 @@ namespace Ogre {
             return *img.getData<const vec4b>(mod(uvi[0], img.getWidth()), mod(uvi[1], img.getHeight()));
         }
 
-        virtual bool fragment(const vec3& bar, ColourValue& gl_FragColor) = 0;
+        /// per vertex outputs of the vertex stage, interpolated for the fragments
+        struct Varyings
+        {
+            vec2 uv[3];
+            vec3 normal[3];
+        };
+
+        /// called concurrently for the pixels of different tiles
+        virtual bool fragment(const vec3& bar, const Varyings& in, ColourValue& gl_FragColor) const = 0;
     };
 
+    struct TileRasterizer;
+
     /**
        Software rasterizer Implementation as a rendering system.
     */
@@ -65,14 +75,20 @@ namespace Ogre {
 
             const Image* image;
 
-            vec2 var_uv[3];
-            vec3 var_normal[3];
-
-            void vertex(const vec4& vertex, const vec2* uv, const vec3* normal, int gl_VertexID,
-                        vec4& gl_Position);
-            bool fragment(const vec3& bar, ColourValue& gl_FragColor) override;
+            /// shade count vertices at once, uv and normal inputs and outputs are optional
+            void vertex(const uchar* vertex, const uchar* uv, const uchar* normal, size_t vertexStep,
+                        size_t uvStep, size_t normalStep, size_t count, vec4* gl_Position, vec2* out_uv,
+                        vec3* out_normal) const;
+            bool fragment(const vec3& bar, const Varyings& in, ColourValue& gl_FragColor) const override;
         } mDefaultShader;
 
+        // post-transform vertex cache, the vertex shader outputs of the current draw
+        std::vector<IShader::vec4> mClipVerts;
+        std::vector<IShader::vec2> mVertexUVs;
+        std::vector<IShader::vec3> mVertexNormals;
+
+        std::unique_ptr<TileRasterizer> mRasterizer;
+
         bool mDepthTest;
         bool mDepthWrite;
         bool mBlendAdd;
@@ -25,7 +25,7 @@
 
 namespace Ogre {
     TinyRenderSystem::TinyRenderSystem()
-        : mHardwareBufferManager(0)
+        : mRasterizer(new TileRasterizer()), mHardwareBufferManager(0)
     {
         LogManager::getSingleton().logMessage(getName() + " created.");
 
@@ -302,22 +302,77 @@ namespace Ogre {
 
     }
 
-    void TinyRenderSystem::DefaultShader::vertex(const vec4& vertex, const vec2* uv, const vec3* normal,
-                                                 int gl_VertexID, vec4& gl_Position)
+    void TinyRenderSystem::DefaultShader::vertex(const uchar* vertex, const uchar* uv, const uchar* normal,
+                                                 size_t vertexStep, size_t uvStep, size_t normalStep, size_t count,
+                                                 vec4* gl_Position, vec2* out_uv, vec3* out_normal) const
     {
-        gl_Position = uniform_MVP * vertex;
+        const int N = floatv::N;
+        const mat3 MVIT = uniform_MVIT.linear();
 
-        if(uv)
-            var_uv[gl_VertexID] = (uniform_Tex*vec4(uv->x, uv->y, 0, 1)).xy();
+        // transform N vertices at a time, with the vertex attributes transposed into lanes
+        for (size_t i = 0; i < count; i += N)
+        {
+            int lanes = std::min<size_t>(N, count - i);
+            float in[3][N] = {}, out[4][N];
+
+            for (int l = 0; l < lanes; l++)
+            {
+                auto v = (const Vector3f*)(vertex + vertexStep * (i + l));
+                for (int k = 0; k < 3; k++)
+                    in[k][l] = (*v)[k];
+            }
+            for (int k = 0; k < 4; k++)
+            {
+                const Real* m = uniform_MVP[k];
+                floatv pos = floatv::load(in[0]) * m[0] + floatv::load(in[1]) * m[1] +
+                             floatv::load(in[2]) * m[2] + m[3];
+                pos.store(out[k]);
+            }
+            for (int l = 0; l < lanes; l++)
+                gl_Position[i + l] = vec4(out[0][l], out[1][l], out[2][l], out[3][l]);
+
+            if (uv)
+            {
+                for (int l = 0; l < lanes; l++)
+                {
+                    auto t = (const vec2*)(uv + uvStep * (i + l));
+                    in[0][l] = t->x;
+                    in[1][l] = t->y;
+                }
+                for (int k = 0; k < 2; k++)
+                {
+                    const Real* m = uniform_Tex[k];
+                    (floatv::load(in[0]) * m[0] + floatv::load(in[1]) * m[1] + m[3]).store(out[k]);
+                }
+                for (int l = 0; l < lanes; l++)
+                    out_uv[i + l] = vec2(out[0][l], out[1][l]);
+            }
 
-        if(normal)
-            var_normal[gl_VertexID] = uniform_MVIT.linear() * *normal;
+            if (normal)
+            {
+                for (int l = 0; l < lanes; l++)
+                {
+                    auto n = (const vec3*)(normal + normalStep * (i + l));
+                    for (int k = 0; k < 3; k++)
+                        in[k][l] = (*n)[k];
+                }
+                for (int k = 0; k < 3; k++)
+                {
+                    const Real* m = MVIT[k];
+                    (floatv::load(in[0]) * m[0] + floatv::load(in[1]) * m[1] + floatv::load(in[2]) * m[2])
+                        .store(out[k]);
+                }
+                for (int l = 0; l < lanes; l++)
+                    out_normal[i + l] = vec3(out[0][l], out[1][l], out[2][l]);
+            }
+        }
     }
-    bool TinyRenderSystem::DefaultShader::fragment(const vec3& bar, ColourValue& gl_FragColor)
+    bool TinyRenderSystem::DefaultShader::fragment(const vec3& bar, const Varyings& in,
+                                                   ColourValue& gl_FragColor) const
     {
         if(image)
         {
-            vec2 uv = var_uv[0]*bar.x + var_uv[1]*bar.y + var_uv[2]*bar.z;
+            vec2 uv = in.uv[0]*bar.x + in.uv[1]*bar.y + in.uv[2]*bar.z;
 
             const vec4b& tex = sample2D(*image, uv);
 
@@ -329,7 +384,7 @@ namespace Ogre {
 
         if(uniform_doLighting)
         {
-            vec3 n = var_normal[0]*bar.x + var_normal[1]*bar.y + var_normal[2]*bar.z;
+            vec3 n = in.normal[0]*bar.x + in.normal[1]*bar.y + in.normal[2]*bar.z;
             float diffuse = std::max(0.f, n.dotProduct(uniform_lightDir));
             gl_FragColor *= diffuse;
             gl_FragColor += uniform_ambientCol;
@@ -374,48 +429,79 @@ namespace Ogre {
 
         mDefaultShader.uniform_doLighting &= bool(normData);
 
-        int16* idx16Data = NULL;
-        int32* idx32Data = NULL;
+        uint16* idx16Data = NULL;
+        uint32* idx32Data = NULL;
         size_t drawCount = op.vertexData->vertexCount;
+        size_t vertexStart = 0, vertexEnd = drawCount; // the vertices used by the draw
         if (op.useIndexes)
         {
             if(op.indexData->indexBuffer->getIndexSize() == 2)
             {
-                idx16Data = (int16*)op.indexData->indexBuffer->lock(HardwareBuffer::HBL_NORMAL);
+                idx16Data = (uint16*)op.indexData->indexBuffer->lock(HardwareBuffer::HBL_NORMAL);
                 idx16Data += op.indexData->indexStart;
             }
             else
             {
-                idx32Data = (int32*)op.indexData->indexBuffer->lock(HardwareBuffer::HBL_NORMAL);
+                idx32Data = (uint32*)op.indexData->indexBuffer->lock(HardwareBuffer::HBL_NORMAL);
                 idx32Data += op.indexData->indexStart;
             }
             op.indexData->indexBuffer->unlock();
             drawCount = op.indexData->indexCount;
+
+            // submeshes with shared vertices only use a part of them
+            vertexStart = vertexEnd = 0;
+            if (drawCount && idx16Data)
+            {
+                auto range = std::minmax_element(idx16Data, idx16Data + drawCount);
+                vertexStart = *range.first;
+                vertexEnd = *range.second + 1;
+            }
+            else if (drawCount)
+            {
+                auto range = std::minmax_element(idx32Data, idx32Data + drawCount);
+                vertexStart = *range.first;
+                vertexEnd = *range.second + 1;
+            }
         }
 
-        Vector3f* v = NULL;
-        Vector2* uv = NULL;
-        Vector3f* n = NULL;
         vec4 clip_vert[3]; // triangle coordinates (clip coordinates), written by VS, read by FS
+        IShader::Varyings varyings;
+        for (int j = 0; j < 3; j++)
+        {
+            varyings.uv[j] = vec2::ZERO;
+            varyings.normal[j] = vec3::ZERO;
+        }
         do
         {
+            // shade every vertex once, shared vertices are then read from the cache
+            size_t vertexCount = vertexEnd - vertexStart;
+            mClipVerts.resize(vertexCount);
+            mVertexUVs.resize(uvData ? vertexCount : 0);
+            mVertexNormals.resize(normData ? vertexCount : 0);
+            mDefaultShader.vertex(posData + posStep * vertexStart, uvData ? uvData + uvStep * vertexStart : NULL,
+                                  normData ? normData + normStep * vertexStart : NULL, posStep, uvStep, normStep,
+                                  vertexCount, mClipVerts.data(), mVertexUVs.data(), mVertexNormals.data());
+
+            // set up and bin all triangles, then rasterize the tiles in parallel
+            mRasterizer->begin(*mActiveColourBuffer);
             for(size_t i = 0; i < drawCount; i += 3)
             {
                 if (i && isStrip)
                     i -= 2;
                 for(int j= 0; j < 3; j++)
                 {
-                    int idx = i + j;
-                    idx = idx16Data ? idx16Data[idx] : (idx32Data ? idx32Data[idx] : idx);
-                    v = (Vector3f*)(posData + posStep*idx);
-                    uv = (Vector2*)(uvData + uvStep*idx);
-                    n = (Vector3f*)(normData + normStep*idx);
-                    mDefaultShader.vertex(vec4(*v), uv, n, j, clip_vert[j]);
+                    size_t idx = i + j;
+                    idx = (idx16Data ? idx16Data[idx] : (idx32Data ? idx32Data[idx] : idx)) - vertexStart;
+                    clip_vert[j] = mClipVerts[idx];
+                    if (uvData)
+                        varyings.uv[j] = mVertexUVs[idx];
+                    if (normData)
+                        varyings.normal[j] = mVertexNormals[idx];
                 }
-                triangle(mVP, clip_vert, mDefaultShader, *mActiveColourBuffer, *mActiveDepthBuffer,
-                            mDepthTest, mDepthWrite, mBlendAdd, !isStrip);
+                mRasterizer->setup(mVP, clip_vert, varyings, *mActiveColourBuffer, !isStrip);
             }
-
+            mRasterizer->flush(mDefaultShader, *mActiveColourBuffer, *mActiveDepthBuffer, mDepthTest, mDepthWrite,
+                               mBlendAdd);
         } while (updatePassIterationRenderState());
     }
 
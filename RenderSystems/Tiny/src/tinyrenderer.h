@@ -14,6 +14,13 @@ subject to the following restrictions:
 */
 #include <OgreVector.h>
 #include <OgreMatrix4.h>
+#include <OgrePlatformInformation.h>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif __OGRE_HAVE_SSE
+#include <xmmintrin.h>
+#endif
 
 namespace Ogre {
 typedef Vector<2, float> vec2;
@@ -25,64 +32,386 @@ typedef Vector<4, uchar> vec4b;
 typedef Matrix3 mat3;
 typedef Matrix4 mat4;
 
-
-static vec3 barycentric(const vec2 tri[3], const vec2& P) {
-    mat3 ABC(tri[0].x, tri[1].x, tri[2].x,
-             tri[0].y, tri[1].y, tri[2].y,
-             1,     1,          1);
-    //if (ABC.determinant()<1e-6) return vec3(-1,1,1); // for a degenerate triangle generate negative coordinates, it will be thrown away by the rasterizator
-    return ABC.inverse() * vec3(P.x, P.y, 1);
-}
+/// a horizontal span of pixel values, processed at once
+struct floatv
+{
+#if defined(__AVX__)
+    static const int N = 8;
+    __m256 v;
+    floatv() {}
+    floatv(__m256 _v) : v(_v) {}
+    floatv(float f) : v(_mm256_set1_ps(f)) {}
+    static floatv ramp() { return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7); }
+    static floatv load(const float* p) { return _mm256_loadu_ps(p); }
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+    floatv operator+(const floatv& b) const { return _mm256_add_ps(v, b.v); }
+    floatv operator*(const floatv& b) const { return _mm256_mul_ps(v, b.v); }
+    floatv operator/(const floatv& b) const { return _mm256_div_ps(v, b.v); }
+    /// lane masks
+    floatv operator&(const floatv& b) const { return _mm256_and_ps(v, b.v); }
+    floatv operator>=(const floatv& b) const { return _mm256_cmp_ps(v, b.v, _CMP_GE_OQ); }
+    floatv operator<=(const floatv& b) const { return _mm256_cmp_ps(v, b.v, _CMP_LE_OQ); }
+    int mask() const { return _mm256_movemask_ps(v); }
+#elif __OGRE_HAVE_SSE
+    static const int N = 4;
+    __m128 v;
+    floatv() {}
+    floatv(__m128 _v) : v(_v) {}
+    floatv(float f) : v(_mm_set1_ps(f)) {}
+    static floatv ramp() { return _mm_setr_ps(0, 1, 2, 3); }
+    static floatv load(const float* p) { return _mm_loadu_ps(p); }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+    floatv operator+(const floatv& b) const { return _mm_add_ps(v, b.v); }
+    floatv operator*(const floatv& b) const { return _mm_mul_ps(v, b.v); }
+    floatv operator/(const floatv& b) const { return _mm_div_ps(v, b.v); }
+    /// lane masks
+    floatv operator&(const floatv& b) const { return _mm_and_ps(v, b.v); }
+    floatv operator>=(const floatv& b) const { return _mm_cmpge_ps(v, b.v); }
+    floatv operator<=(const floatv& b) const { return _mm_cmple_ps(v, b.v); }
+    int mask() const { return _mm_movemask_ps(v); }
+#else
+    // plain loops, which the compiler can vectorise
+    static const int N = 4;
+    float v[N];
+    floatv() {}
+    floatv(float f) { for (int i = 0; i < N; i++) v[i] = f; }
+    static floatv ramp() { floatv r; for (int i = 0; i < N; i++) r.v[i] = i; return r; }
+    static floatv load(const float* p) { floatv r; for (int i = 0; i < N; i++) r.v[i] = p[i]; return r; }
+    void store(float* p) const { for (int i = 0; i < N; i++) p[i] = v[i]; }
+    floatv operator+(const floatv& b) const { floatv r; for (int i = 0; i < N; i++) r.v[i] = v[i] + b.v[i]; return r; }
+    floatv operator*(const floatv& b) const { floatv r; for (int i = 0; i < N; i++) r.v[i] = v[i] * b.v[i]; return r; }
+    floatv operator/(const floatv& b) const { floatv r; for (int i = 0; i < N; i++) r.v[i] = v[i] / b.v[i]; return r; }
+    /// lane masks
+    floatv operator&(const floatv& b) const { floatv r; for (int i = 0; i < N; i++) r.v[i] = v[i] && b.v[i]; return r; }
+    floatv operator>=(const floatv& b) const { floatv r; for (int i = 0; i < N; i++) r.v[i] = v[i] >= b.v[i]; return r; }
+    floatv operator<=(const floatv& b) const { floatv r; for (int i = 0; i < N; i++) r.v[i] = v[i] <= b.v[i]; return r; }
+    int mask() const { int m = 0; for (int i = 0; i < N; i++) m |= (v[i] != 0) << i; return m; }
+#endif
+};
 
 static float cross(const vec2 &v1, const vec2 &v2) {
     return v1.x * v2.y - v1.y * v2.x;
 }
 
-/// triangle screen coordinates before persp. division
-static void triangle(const mat4& Viewport, const vec4 clip_verts[3], IShader& shader, Image& image,
-                     Image& zbuffer, bool depthCheck, bool depthWrite, bool blendAdd, bool doCull)
+/// a triangle after vertex processing and setup, ready to be rasterized
+struct SetupTriangle
 {
-    vec4 pts[3]  = { Viewport*clip_verts[0],    Viewport*clip_verts[1],    Viewport*clip_verts[2]    };  // triangle screen coordinates before persp. division
-    for (int i = 0; i < 3; i++)
+    vec4 pts[3];  // screen coordinates after persp. division, w holds 1/w
+    vec2 origin;  // screen coordinates of the first vertex
+    // the screen space barycentric coordinates are 1,0,0 at the origin and change by these per pixel
+    vec3 dx;
+    vec3 dy;
+    float zmin;   // lower bound of the fragment depths
+    IShader::Varyings varyings;
+    int bboxmin[2];
+    int bboxmax[2];
+};
+
+/** Bins the triangles of a draw into screen tiles, which are then rasterized in parallel
+
+    Every tile keeps its triangles in submission order and covers its own pixels, so the tiles
+    need no synchronisation and the result is the same as rasterizing the triangles in order.
+*/
+struct TileRasterizer
+{
+    static const int TILE_SIZE = 64;
+    static const int BLOCK_SIZE = 8;
+    /// near, far and the four guard band planes
+    static const int CLIP_PLANES = 6;
+    /// size of the guard band in normalised device coordinates, keeps the screen coordinates precise
+    static constexpr float GUARD_BAND = 16;
+
+    struct ClipVertex
     {
-        float w = pts[i][3];
-        pts[i] /= w;
-        pts[i][3] = 1 / w;
+        vec4 pos;
+        vec3 weights; // barycentric coordinates in the original triangle
+    };
+
+    std::vector<SetupTriangle> triangles;
+    std::vector<std::vector<uint32>> bins; // triangle indices per tile
+    int tilesX = 0;
+    int tilesY = 0;
+
+    void begin(const Image& image)
+    {
+        triangles.clear();
+        tilesX = (image.getWidth() + TILE_SIZE - 1) / TILE_SIZE;
+        tilesY = (image.getHeight() + TILE_SIZE - 1) / TILE_SIZE;
+        bins.resize(tilesX * tilesY);
+        for (auto& bin : bins)
+            bin.clear();
     }
 
-    vec2 pts2[3] = { pts[0].xy(), pts[1].xy(), pts[2].xy() };  // triangle screen coordinates after  perps. division
+    /** clip the triangle in homogeneous space and set up the remaining parts
+
+        Clipping at the near and far planes keeps the vertices in front of the camera. Against x and y
+        the triangles are only clipped at a guard band around the viewport, as the bounding box
+        rejects the pixels outside, which leaves most triangles at the viewport borders unclipped.
+    */
+    void setup(const mat4& Viewport, const vec4 clip_verts[3], const IShader::Varyings& varyings, const Image& image,
+               bool doCull)
+    {
+        int outsideAll = (1 << CLIP_PLANES) - 1, outsideAny = 0;
+        for (int i = 0; i < 3; i++)
+        {
+            int outside = 0;
+            for (int p = 0; p < CLIP_PLANES; p++)
+                outside |= (clipDistance(clip_verts[i], p) < 0) << p;
+            outsideAll &= outside;
+            outsideAny |= outside;
+        }
 
-    if(doCull && cross(pts2[2] - pts2[0], pts2[2] - pts2[1]) > 0)
-        return; // culled
+        if (outsideAll)
+            return; // entirely outside of a plane
 
-    vec2 bboxmin( std::numeric_limits<float>::max(),  std::numeric_limits<float>::max());
-    vec2 bboxmax(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
-    vec2 clamp(image.getWidth()-1, image.getHeight()-1);
-    for (int i=0; i<3; i++)
-        for (int j=0; j<2; j++) {
-            bboxmin[j] = std::max(0.f,       std::min(bboxmin[j], pts2[i][j]));
-            bboxmax[j] = std::min(clamp[j], std::max(bboxmax[j], pts2[i][j]));
+        if (!outsideAny)
+        {
+            setupTriangle(Viewport, clip_verts, varyings, image, doCull);
+            return;
         }
 
-#pragma omp parallel for
-    for (int x=(int)bboxmin.x; x<=(int)bboxmax.x; x++) {
-        for (int y=(int)bboxmin.y; y<=(int)bboxmax.y; y++) {
-            vec3 bc_screen  = barycentric(pts2, vec2(x, y));
-            vec3 bc_clip    = vec3(bc_screen.x*pts[0][3], bc_screen.y*pts[1][3], bc_screen.z*pts[2][3]);
-            bc_clip = bc_clip/(bc_clip.x+bc_clip.y+bc_clip.z); // check https://github.com/ssloy/tinyrenderer/wiki/Technical-difficulties-linear-interpolation-with-perspective-deformations
-            float frag_depth = vec3(pts[0][2], pts[1][2], pts[2][2]).dotProduct(bc_clip);
-            if (bc_screen.x<0 || bc_screen.y<0 || bc_screen.z<0) continue;
+        // Sutherland-Hodgman, the vertices keep their weights of the original vertices for the varyings
+        ClipVertex polygon[3 + CLIP_PLANES], clipped[3 + CLIP_PLANES];
+        int count = 3;
+        for (int i = 0; i < 3; i++)
+        {
+            polygon[i].pos = clip_verts[i];
+            polygon[i].weights = vec3::ZERO;
+            polygon[i].weights[i] = 1;
+        }
 
-            if (frag_depth < 0.0)
+        for (int p = 0; p < CLIP_PLANES && count; p++)
+        {
+            if (!(outsideAny & (1 << p)))
                 continue;
 
-            if(depthCheck && frag_depth > *zbuffer.getData<float>(x, y))
+            int clippedCount = 0;
+            for (int i = 0; i < count; i++)
+            {
+                const ClipVertex& a = polygon[i];
+                const ClipVertex& b = polygon[(i + 1) % count];
+                float da = clipDistance(a.pos, p), db = clipDistance(b.pos, p);
+                if (da >= 0)
+                    clipped[clippedCount++] = a;
+                if ((da >= 0) != (db >= 0))
+                {
+                    float t = da / (da - db);
+                    clipped[clippedCount].pos = a.pos + (b.pos - a.pos) * t;
+                    clipped[clippedCount].weights = a.weights + (b.weights - a.weights) * t;
+                    clippedCount++;
+                }
+            }
+            std::copy(clipped, clipped + clippedCount, polygon);
+            count = clippedCount;
+        }
+
+        // triangulate the convex polygon as a fan
+        for (int i = 1; i + 1 < count; i++)
+        {
+            const ClipVertex* verts[3] = {&polygon[0], &polygon[i], &polygon[i + 1]};
+            vec4 fan_verts[3];
+            IShader::Varyings fan_varyings;
+            for (int j = 0; j < 3; j++)
+            {
+                const vec3& w = verts[j]->weights;
+                fan_verts[j] = verts[j]->pos;
+                fan_varyings.uv[j] = varyings.uv[0] * w[0] + varyings.uv[1] * w[1] + varyings.uv[2] * w[2];
+                fan_varyings.normal[j] =
+                    varyings.normal[0] * w[0] + varyings.normal[1] * w[1] + varyings.normal[2] * w[2];
+            }
+            setupTriangle(Viewport, fan_verts, fan_varyings, image, doCull);
+        }
+    }
+
+    /// signed distance of a vertex in clip coordinates to a clip plane, negative outside
+    static float clipDistance(const vec4& v, int plane)
+    {
+        switch (plane)
+        {
+        case 0: return v.z + v.w; // near
+        case 1: return v.w - v.z; // far
+        case 2: return GUARD_BAND * v.w + v.x;
+        case 3: return GUARD_BAND * v.w - v.x;
+        case 4: return GUARD_BAND * v.w + v.y;
+        default: return GUARD_BAND * v.w - v.y;
+        }
+    }
+
+    /// triangle in front of the camera and inside the guard band
+    void setupTriangle(const mat4& Viewport, const vec4 clip_verts[3], const IShader::Varyings& varyings,
+                       const Image& image, bool doCull)
+    {
+        SetupTriangle tri;
+        auto& pts = tri.pts;
+        vec2 pts2[3];
+        for (int i = 0; i < 3; i++)
+        {
+            pts[i] = Viewport*clip_verts[i]; // triangle screen coordinates before persp. division
+            float w = pts[i][3];
+            pts[i] /= w;
+            pts[i][3] = 1 / w;
+            pts2[i] = pts[i].xy(); // triangle screen coordinates after  perps. division
+        }
+
+        if(doCull && cross(pts2[2] - pts2[0], pts2[2] - pts2[1]) > 0)
+            return; // culled
+
+        float area = cross(pts2[1] - pts2[0], pts2[2] - pts2[0]);
+        if (!(area != 0))
+            return; // degenerate
+
+        // the fragment depths are interpolated between the vertex depths
+        tri.zmin = std::min(std::min(pts[0][2], pts[1][2]), pts[2][2]);
+
+        vec2 bboxmin( std::numeric_limits<float>::max(),  std::numeric_limits<float>::max());
+        vec2 bboxmax(-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max());
+        vec2 clamp(image.getWidth()-1, image.getHeight()-1);
+        for (int i=0; i<3; i++)
+            for (int j=0; j<2; j++) {
+                bboxmin[j] = std::max(0.f,       std::min(bboxmin[j], pts2[i][j]));
+                bboxmax[j] = std::min(clamp[j], std::max(bboxmax[j], pts2[i][j]));
+            }
+
+        for (int j = 0; j < 2; j++)
+        {
+            tri.bboxmin[j] = bboxmin[j];
+            tri.bboxmax[j] = bboxmax[j];
+        }
+        if (tri.bboxmin[0] > tri.bboxmax[0] || tri.bboxmin[1] > tri.bboxmax[1])
+            return; // off screen
+
+        // edge functions, normalised to give the barycentric coordinates
+        tri.origin = pts2[0];
+        tri.dx = vec3(pts2[1].y - pts2[2].y, pts2[2].y - pts2[0].y, pts2[0].y - pts2[1].y) / area;
+        tri.dy = vec3(pts2[2].x - pts2[1].x, pts2[0].x - pts2[2].x, pts2[1].x - pts2[0].x) / area;
+
+        tri.varyings = varyings;
+        uint32 index = triangles.size();
+        triangles.push_back(tri);
+
+        for (int ty = tri.bboxmin[1] / TILE_SIZE; ty <= tri.bboxmax[1] / TILE_SIZE; ty++)
+            for (int tx = tri.bboxmin[0] / TILE_SIZE; tx <= tri.bboxmax[0] / TILE_SIZE; tx++)
+                bins[ty * tilesX + tx].push_back(index);
+    }
+
+    void flush(const IShader& shader, Image& image, Image& zbuffer, bool depthCheck, bool depthWrite,
+               bool blendAdd) const
+    {
+#pragma omp parallel for schedule(dynamic)
+        for (int tile = 0; tile < int(bins.size()); tile++)
+        {
+            int tx = tile % tilesX, ty = tile / tilesX;
+            int tilemin[2] = {tx * TILE_SIZE, ty * TILE_SIZE};
+            int tilemax[2] = {tilemin[0] + TILE_SIZE - 1, tilemin[1] + TILE_SIZE - 1};
+            for (auto index : bins[tile])
+                triangle(triangles[index], tilemin, tilemax, shader, image, zbuffer, depthCheck, depthWrite,
+                         blendAdd);
+        }
+    }
+
+    /// rasterize the part of the triangle inside the given tile
+    static void triangle(const SetupTriangle& tri, const int tilemin[2], const int tilemax[2],
+                         const IShader& shader, Image& image, Image& zbuffer, bool depthCheck, bool depthWrite,
+                         bool blendAdd)
+    {
+        int xmin = std::max(tri.bboxmin[0], tilemin[0]), xmax = std::min(tri.bboxmax[0], tilemax[0]);
+        int ymin = std::max(tri.bboxmin[1], tilemin[1]), ymax = std::min(tri.bboxmax[1], tilemax[1]);
+
+        // walk the bounding box in blocks, skipping the ones outside of the triangle or behind the depth buffer
+        for (int by = ymin; by <= ymax; by += BLOCK_SIZE) {
+            for (int bx = xmin; bx <= xmax; bx += BLOCK_SIZE) {
+                int bxmax = std::min(bx + BLOCK_SIZE - 1, xmax), bymax = std::min(by + BLOCK_SIZE - 1, ymax);
+
+                bool outside = false, covered = true;
+                for (int i = 0; i < 3 && !outside; i++)
+                {
+                    // the edge functions are linear, so their extremes are at the block corners
+                    float hix = tri.dx[i] > 0 ? bxmax : bx, lox = tri.dx[i] > 0 ? bx : bxmax;
+                    float hiy = tri.dy[i] > 0 ? bymax : by, loy = tri.dy[i] > 0 ? by : bymax;
+                    outside = barycentric(tri, i, hix, hiy) < 0;
+                    covered &= barycentric(tri, i, lox, loy) >= 0;
+                }
+                if (outside)
+                    continue;
+
+                if (depthCheck && tri.zmin > maxDepth(zbuffer, bx, by, bxmax, bymax))
+                    continue;
+
+                for (int y = by; y <= bymax; y++)
+                    for (int x = bx; x <= bxmax; x += floatv::N)
+                        span(tri, x, y, bxmax, covered, shader, image, zbuffer, depthCheck, depthWrite, blendAdd);
+            }
+        }
+    }
+
+    static float barycentric(const SetupTriangle& tri, int i, float x, float y)
+    {
+        return (i == 0) + tri.dx[i] * (x - tri.origin.x) + tri.dy[i] * (y - tri.origin.y);
+    }
+
+    static float maxDepth(const Image& zbuffer, int xmin, int ymin, int xmax, int ymax)
+    {
+        float depth = -std::numeric_limits<float>::max();
+        for (int y = ymin; y <= ymax; y++)
+            for (int x = xmin; x <= xmax; x++)
+                depth = std::max(depth, *zbuffer.getData<float>(x, y));
+        return depth;
+    }
+
+    /// shade up to floatv::N pixels starting at x, y
+    static void span(const SetupTriangle& tri, int x, int y, int xmax, bool covered, const IShader& shader,
+                     Image& image, Image& zbuffer, bool depthCheck, bool depthWrite, bool blendAdd)
+    {
+        auto& pts = tri.pts;
+        floatv fx = floatv::ramp() + float(x - tri.origin.x);
+        float fy = y - tri.origin.y;
+        floatv mask = floatv::ramp() <= float(xmax - x);
+
+        floatv bc_screen[3];
+        for (int i = 0; i < 3; i++)
+        {
+            bc_screen[i] = fx * tri.dx[i] + (float(i == 0) + tri.dy[i] * fy);
+            if (!covered)
+                mask = mask & (bc_screen[i] >= 0.f);
+        }
+        if (!mask.mask())
+            return;
+
+        floatv bc_clip[3] = {bc_screen[0] * pts[0][3], bc_screen[1] * pts[1][3], bc_screen[2] * pts[2][3]};
+        floatv sum = bc_clip[0] + bc_clip[1] + bc_clip[2];
+        for (int i = 0; i < 3; i++)
+            bc_clip[i] = bc_clip[i] / sum; // check https://github.com/ssloy/tinyrenderer/wiki/Technical-difficulties-linear-interpolation-with-perspective-deformations
+        floatv frag_depth = bc_clip[0] * pts[0][2] + bc_clip[1] * pts[1][2] + bc_clip[2] * pts[2][2];
+        mask = mask & (frag_depth >= 0.f);
+
+        float* zrow = zbuffer.getData<float>(x, y);
+        if (depthCheck)
+        {
+            // do not read past the end of the buffer
+            float zvals[floatv::N];
+            int count = std::min(int(floatv::N), int(zbuffer.getWidth()) - x);
+            std::copy(zrow, zrow + count, zvals);
+            mask = mask & (frag_depth <= floatv::load(zvals));
+        }
+
+        int lanes = mask.mask();
+        if (!lanes)
+            return;
+
+        float bc[3][floatv::N], depth[floatv::N];
+        for (int i = 0; i < 3; i++)
+            bc_clip[i].store(bc[i]);
+        frag_depth.store(depth);
+
+        for (int l = 0; l < floatv::N; l++)
+        {
+            if (!(lanes & (1 << l)))
                 continue;
 
             ColourValue fragColour;
-            bool discard = shader.fragment(bc_clip, fragColour);
+            bool discard = shader.fragment(vec3(bc[0][l], bc[1][l], bc[2][l]), tri.varyings, fragColour);
             if (discard) continue;
-            auto& dst = *image.getData<vec3b>(x, y);
+            auto& dst = *image.getData<vec3b>(x + l, y);
             if(blendAdd)
                 fragColour += ColourValue(vec4b(dst[0], dst[1], dst[2], 0).ptr());
             fragColour.saturate();
@@ -90,8 +419,8 @@ static void triangle(const mat4& Viewport, const vec4 clip_verts[3], IShader& sh
 
             dst = vec3b(fragColour.ptr());
             if (depthWrite)
-                *zbuffer.getData<float>(x, y) = frag_depth;
+                zrow[l] = depth[l];
         }
     }
+};
 }
-}
\ No newline at end of file
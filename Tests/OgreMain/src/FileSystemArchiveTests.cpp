@@ -312,3 +312,23 @@ TEST_F(FileSystemArchiveTests,CreateAndRemoveFile)
     EXPECT_TRUE(!mArch->exists(fileName));
 }
 //--------------------------------------------------------------------------
+TEST_F(FileSystemArchiveTests,MemoryMapped)
+{
+    FileSystemArchiveFactory::setUseMemoryMapping(true);
+
+    DataStreamPtr stream = mArch->open("rootfile.txt");
+    EXPECT_TRUE(dynamic_cast<MmapDataStream*>(stream.get()));
+    EXPECT_EQ(String("rootfile.txt"), stream->getName());
+    EXPECT_EQ((size_t)mFileSizeRoot1, stream->size());
+    EXPECT_EQ(String("this is line 1 in file 1"), stream->getLine());
+    stream->seek(stream->size() - 25);
+    EXPECT_EQ(String("this is line 5 in file 1"), stream->getLine());
+    EXPECT_TRUE(stream->eof());
+
+    // writable opens are not mapped
+    EXPECT_FALSE(dynamic_cast<MmapDataStream*>(mArch->open("rootfile.txt", false).get()));
+    EXPECT_THROW(mArch->open("missing.txt"), FileNotFoundException);
+
+    FileSystemArchiveFactory::setUseMemoryMapping(false);
+}
+//--------------------------------------------------------------------------
@@ -0,0 +1,149 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+
+#include "RootWithoutRenderSystemFixture.h"
+#include "OgreCamera.h"
+#include "OgreTimer.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+struct BatchCullingTest : public RootWithoutRenderSystemFixture
+{
+    std::unique_ptr<Camera> mCamera;
+    std::vector<Vector3> mCentres;
+    std::vector<Vector3> mHalfSizes;
+    std::vector<Sphere> mSpheres;
+
+    void SetUp() override
+    {
+        RootWithoutRenderSystemFixture::SetUp();
+        mCamera.reset(new Camera("", NULL));
+        mCamera->setNearClipDistance(1);
+        mCamera->setFarClipDistance(100);
+    }
+
+    void TearDown() override
+    {
+        mCamera.reset();
+        RootWithoutRenderSystemFixture::TearDown();
+    }
+
+    void createVolumes(size_t count, Real extent)
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<Real> pos(-extent, extent);
+        std::uniform_real_distribution<Real> size(0, 10);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            mCentres.emplace_back(pos(rng), pos(rng), pos(rng));
+            mHalfSizes.emplace_back(size(rng), size(rng), size(rng));
+            mSpheres.emplace_back(mCentres.back(), size(rng));
+        }
+    }
+
+    AxisAlignedBox getBox(size_t i) const
+    {
+        return AxisAlignedBox(mCentres[i] - mHalfSizes[i], mCentres[i] + mHalfSizes[i]);
+    }
+
+    void expectSameAsScalar()
+    {
+        size_t count = mCentres.size();
+        std::vector<uint32> boxes((count + 31) / 32, 0xFFFFFFFF);
+        std::vector<uint32> spheres((count + 31) / 32, 0xFFFFFFFF);
+        mCamera->isVisible(mCentres.data(), mHalfSizes.data(), count, boxes.data());
+        mCamera->isVisible(mSpheres.data(), count, spheres.data());
+
+        size_t numVisible = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            bool box = boxes[i / 32] & (1u << (i % 32));
+            bool sphere = spheres[i / 32] & (1u << (i % 32));
+            EXPECT_EQ(box, mCamera->isVisible(getBox(i))) << i;
+            EXPECT_EQ(sphere, mCamera->isVisible(mSpheres[i])) << i;
+            numVisible += box;
+        }
+
+        // the bits beyond count are cleared
+        if (count % 32)
+        {
+            EXPECT_EQ(boxes.back() >> (count % 32), 0u);
+            EXPECT_EQ(spheres.back() >> (count % 32), 0u);
+        }
+
+        // make sure both cases are covered
+        EXPECT_GT(numVisible, 0u);
+        EXPECT_LT(numVisible, count);
+    }
+};
+} // namespace
+
+TEST_F(BatchCullingTest, SameAsScalar)
+{
+    // not a multiple of the SIMD width
+    createVolumes(1003, 150);
+    expectSameAsScalar();
+
+    mCamera->setFarClipDistance(0);
+    expectSameAsScalar();
+
+    mCamera->setProjectionType(PT_ORTHOGRAPHIC);
+    mCamera->setOrthoWindow(100, 100);
+    expectSameAsScalar();
+}
+
+TEST_F(BatchCullingTest, Small)
+{
+    for (int n = 0; n < 8; n++)
+    {
+        createVolumes(1, 20);
+        std::vector<uint32> boxes(1, 0xFFFFFFFF);
+        mCamera->isVisible(mCentres.data(), mHalfSizes.data(), mCentres.size(), boxes.data());
+        for (size_t i = 0; i < mCentres.size(); i++)
+            EXPECT_EQ(bool(boxes[0] & (1u << i)), mCamera->isVisible(getBox(i)));
+        EXPECT_EQ(boxes[0] >> mCentres.size(), 0u);
+    }
+}
+
+TEST_F(BatchCullingTest, Benchmark)
+{
+    createVolumes(50000, 150);
+
+    std::vector<AxisAlignedBox> boxes;
+    for (size_t i = 0; i < mCentres.size(); i++)
+        boxes.push_back(getBox(i));
+    std::vector<uint32> visibility((boxes.size() + 31) / 32);
+
+    const int iterations = 20;
+    Timer timer;
+    size_t numScalar = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+        for (const auto& box : boxes)
+            numScalar += mCamera->isVisible(box);
+    }
+    auto scalar = timer.getMicroseconds();
+
+    timer.reset();
+    size_t numBatch = 0;
+    for (int i = 0; i < iterations; i++)
+    {
+        mCamera->isVisible(mCentres.data(), mHalfSizes.data(), mCentres.size(), visibility.data());
+        for (size_t j = 0; j < mCentres.size(); j++)
+            numBatch += (visibility[j / 32] >> (j % 32)) & 1;
+    }
+    auto batch = timer.getMicroseconds();
+
+    EXPECT_EQ(numScalar, numBatch);
+    printf("frustum culling of %zu boxes: scalar %.3fms, batch %.3fms\n", boxes.size(),
+           scalar / (1000.0 * iterations), batch / (1000.0 * iterations));
+}
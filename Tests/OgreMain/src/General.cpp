@@ -43,14 +43,20 @@ THE SOFTWARE.
 #include "OgreHighLevelGpuProgramManager.h"
 #include "OgreMeshManager.h"
 #include "OgreMesh.h"
+#include "OgreCompiledAnimation.h"
+#include "OgreSubMesh.h"
+#include "OgreSubEntity.h"
 #include "OgreSkeletonManager.h"
 #include "OgreSkeletonInstance.h"
 #include "OgreCompositorManager.h"
 #include "OgreTextureManager.h"
 #include "OgreFileSystem.h"
 #include "OgreArchiveManager.h"
+#include "OgreWorkQueue.h"
+#include "OgreFileSystemLayer.h"
 
 #include "OgreHighLevelGpuProgram.h"
+#include "OgreAutoParamDataSource.h"
 
 #include "OgreKeyFrame.h"
 
@@ -479,6 +485,51 @@ TEST_F(ResourceLoading, CollsionDeleteExisting)
     EXPECT_TRUE(mat->clone("Collision"));
 }
 
+TEST_F(ResourceLoading, ParallelLoading)
+{
+    auto& rgm = ResourceGroupManager::getSingleton();
+    mRoot->getWorkQueue()->startup();
+    rgm.setParallelLoading(true);
+
+    // scripts are tokenized on the workers and compiled on this thread
+    rgm.createResourceGroup("ParallelScripts", false);
+    rgm.addResourceLocation(".", "FileSystem", "ParallelScripts", false, false);
+    for (int i = 0; i < 4; i++)
+    {
+        String script = StringUtil::format("material Parallel%d { technique { pass { diffuse %d 0 0 } } }", i, i);
+        rgm.createResource(StringUtil::format("parallel%d.material", i), "ParallelScripts")
+            ->write(script.c_str(), script.size());
+    }
+    rgm.initialiseResourceGroup("ParallelScripts");
+    for (int i = 0; i < 4; i++)
+    {
+        rgm.deleteResource(StringUtil::format("parallel%d.material", i), "ParallelScripts");
+        auto mat = MaterialManager::getSingleton().getByName(StringUtil::format("Parallel%d", i), "ParallelScripts");
+        ASSERT_TRUE(mat);
+        EXPECT_EQ(mat->getTechnique(0)->getPass(0)->getDiffuse(), ColourValue(i, 0, 0));
+    }
+
+    // meshes are read on the workers and loaded on this thread
+    auto archive = rgm.findResourceFileInfo(RGN_DEFAULT, "ogrehead.mesh")->at(0).archive;
+    rgm.createResourceGroup("ParallelMeshes", false);
+    rgm.addResourceLocation(archive->getName(), archive->getType(), "ParallelMeshes");
+    std::vector<MeshPtr> meshes;
+    auto names = archive->find("*.mesh", false);
+    for (const auto& name : *names)
+        meshes.push_back(MeshManager::getSingleton().create(name, "ParallelMeshes"));
+    ASSERT_FALSE(meshes.empty());
+
+    rgm.loadResourceGroup("ParallelMeshes");
+    for (const auto& mesh : meshes)
+    {
+        EXPECT_TRUE(mesh->isLoaded());
+        EXPECT_GT(mesh->getNumSubMeshes(), 0u);
+    }
+
+    rgm.setParallelLoading(false);
+    mRoot->getWorkQueue()->shutdown();
+}
+
 typedef RootWithoutRenderSystemFixture TextureTests;
 TEST_F(TextureTests, Blank)
 {
@@ -545,6 +596,40 @@ TEST_F(HighLevelGpuProgramTest, resolveIncludes)
     ASSERT_EQ(res.substr(0, ref.size()), ref);
 }
 
+TEST_F(HighLevelGpuProgramTest, MicrocodeCacheDirectory)
+{
+    auto& gpm = GpuProgramManager::getSingleton();
+    gpm.setMicrocodeCacheDirectory("MicrocodeCache");
+
+    String code = "compiled program";
+    auto microcode = GpuProgramManager::createMicrocode(code.size());
+    microcode->write(code.data(), code.size());
+    gpm.addMicrocodeToCache(42, microcode);
+
+    // drop the cached microcodes, so they are read from the directory
+    auto emptyCache = std::make_shared<MemoryDataStream>(size_t(0));
+    gpm.loadMicrocodeCache(emptyCache);
+    ASSERT_TRUE(gpm.isMicrocodeAvailableInCache(42));
+    EXPECT_FALSE(gpm.isMicrocodeAvailableInCache(43));
+    EXPECT_EQ(code, gpm.getMicrocodeFromCache(42)->getAsString());
+
+    // corrupt files are ignored
+    auto files = ArchiveManager::getSingleton().load("MicrocodeCache", "FileSystem", false);
+    auto names = files->find("*.bin");
+    ASSERT_EQ(names->size(), 1u);
+    files->create(names->at(0))->write("corrupt", 7);
+    gpm.loadMicrocodeCache(emptyCache);
+    EXPECT_FALSE(gpm.isMicrocodeAvailableInCache(42));
+
+    gpm.addMicrocodeToCache(42, microcode);
+    gpm.removeMicrocodeFromCache(42);
+    EXPECT_FALSE(files->exists(names->at(0)));
+
+    ArchiveManager::getSingleton().unload(files);
+    gpm.setMicrocodeCacheDirectory("");
+    FileSystemLayer::removeDirectory("MicrocodeCache");
+}
+
 TEST(Math, TriangleRayIntersection)
 {
     Vector3 tri[3] = {{-1, 0, 0}, {1, 0, 0}, {0, 1, 0}};
@@ -573,6 +658,111 @@ TEST_F(SkeletonTests, linkedSkeletonAnimationSource)
     EXPECT_TRUE(entity->getAnimationState("Stealth")); // animation from ninja.sekeleton
 }
 
+static std::vector<float> getSkinnedPositions(Entity* entity)
+{
+    std::vector<VertexData*> vertexData;
+    if (entity->getMesh()->sharedVertexData)
+        vertexData.push_back(entity->_getSkelAnimVertexData());
+    for (auto se : entity->getSubEntities())
+    {
+        if (!se->getSubMesh()->useSharedVertices)
+            vertexData.push_back(se->_getSkelAnimVertexData());
+    }
+
+    std::vector<float> ret;
+    for (auto vd : vertexData)
+    {
+        auto posElem = vd->vertexDeclaration->findElementBySemantic(VES_POSITION);
+        auto buf = vd->vertexBufferBinding->getBuffer(posElem->getSource());
+        HardwareBufferLockGuard lock(buf, HardwareBuffer::HBL_READ_ONLY);
+        for (size_t i = 0; i < vd->vertexCount; i++)
+        {
+            float* pos;
+            posElem->baseVertexPointerToElement(static_cast<uchar*>(lock.pData) + i * buf->getVertexSize(), &pos);
+            ret.insert(ret.end(), pos, pos + 3);
+        }
+    }
+    return ret;
+}
+
+TEST_F(SkeletonTests, ParallelSoftwareSkinning)
+{
+    auto sceneMgr = mRoot->createSceneManager();
+    sceneMgr->setParallelSoftwareSkinning(true);
+
+    // the last one is not batched, as reference
+    Entity* entities[3];
+    for (int i = 0; i < 3; i++)
+    {
+        entities[i] = sceneMgr->createEntity("jaiqua.mesh");
+        auto state = entities[i]->getAnimationState("Sneak");
+        state->setEnabled(true);
+        state->setTimePosition(0.5f + i * 0.1f);
+    }
+    entities[2]->getAnimationState("Sneak")->setTimePosition(0.5f);
+
+    sceneMgr->_beginSoftwareSkinning();
+    entities[0]->_updateAnimation();
+    entities[1]->_updateAnimation();
+    sceneMgr->_endSoftwareSkinning();
+    entities[2]->_updateAnimation();
+
+    auto positions = getSkinnedPositions(entities[0]);
+    ASSERT_FALSE(positions.empty());
+    EXPECT_EQ(positions, getSkinnedPositions(entities[2]));
+    EXPECT_NE(positions, getSkinnedPositions(entities[1]));
+}
+
+static std::vector<Real> getPose(Skeleton* skel, Animation* anim, Real time)
+{
+    skel->reset();
+    anim->apply(skel, time);
+
+    std::vector<Real> ret;
+    for (auto b : skel->getBones())
+    {
+        Quaternion q = b->getOrientation();
+        if (q.w < 0)
+            q = -q;
+        const Vector3& pos = b->getPosition();
+        const Vector3& scale = b->getScale();
+        ret.insert(ret.end(), {pos.x, pos.y, pos.z, q.w, q.x, q.y, q.z, scale.x, scale.y, scale.z});
+    }
+    return ret;
+}
+
+TEST_F(SkeletonTests, CompiledAnimation)
+{
+    auto skel = SkeletonManager::getSingleton().load("jaiqua.skeleton", RGN_DEFAULT);
+    auto anim = skel->getAnimation("Sneak");
+    const Real times[] = {0, 0.1, 0.77, 1.5, anim->getLength(), anim->getLength() + 0.3};
+
+    std::vector<std::vector<Real>> expected;
+    for (auto t : times)
+        expected.push_back(getPose(skel.get(), anim, t));
+
+    size_t floatMemory = 0;
+    for (bool quantise : {false, true})
+    {
+        anim->compile(60, quantise);
+        ASSERT_TRUE(anim->getCompiled());
+        EXPECT_EQ(anim->getCompiled()->isQuantised(), quantise);
+        double maxErr = 0;
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            auto pose = getPose(skel.get(), anim, times[i]);
+            ASSERT_EQ(pose.size(), expected[i].size());
+            for (size_t j = 0; j < pose.size(); j++)
+                maxErr = std::max<double>(maxErr, std::abs(pose[j] - expected[i][j]));
+        }
+        printf("quantise %d maxErr %g mem %zu samples %zu\n", quantise, maxErr, anim->getCompiled()->getSampleMemoryUsage(), anim->getCompiled()->getNumSamples());
+    }
+
+    // structural changes discard the compiled tracks
+    anim->getNodeTrack(anim->_getNodeTrackList().begin()->first)->createNodeKeyFrame(0.05);
+    EXPECT_FALSE(anim->getCompiled());
+}
+
 TEST(MaterialLoading, LateShadowCaster)
 {
     Root root("");
@@ -663,6 +853,59 @@ TEST(GpuProgramParams, Variability)
     EXPECT_EQ(params.getConstantDefinition("parameter").variability, GPV_PER_OBJECT);
 }
 
+TEST(GpuProgramParams, SkipUnchangedAutoConstants)
+{
+    auto constants = std::make_shared<GpuNamedConstants>();
+    GpuConstantDefinition def;
+    def.constType = GCT_FLOAT4;
+    def.elementSize = 4;
+    def.arraySize = 1;
+    def.physicalIndex = 0;
+    constants->map["ambient"] = def;
+    def.constType = GCT_MATRIX_4X4;
+    def.elementSize = 16;
+    def.physicalIndex = 4 * sizeof(float);
+    constants->map["world"] = def;
+    constants->bufferSize = 20;
+
+    GpuProgramParameters params;
+    params._setNamedConstants(constants);
+    params.setNamedAutoConstant("ambient", GpuProgramParameters::ACT_AMBIENT_LIGHT_COLOUR);
+    params.setNamedAutoConstant("world", GpuProgramParameters::ACT_WORLD_MATRIX);
+    const float* ambient = params.getFloatPointer(0);
+    const float* world = params.getFloatPointer(4 * sizeof(float));
+
+    AutoParamDataSource source;
+    Affine3 transform(Vector3(1, 2, 3), Quaternion::IDENTITY);
+    source.setWorldMatrices(&transform, 1);
+    source.setAmbientLightColour(ColourValue::Red);
+    params._updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(ambient[0], 1);
+    EXPECT_EQ(world[3], 1);
+
+    // the ambient colour did not change, so it is not written again
+    params.setNamedConstant("ambient", ColourValue::Green);
+    Affine3 moved(Vector3(4, 5, 6), Quaternion::IDENTITY);
+    source.setWorldMatrices(&moved, 1);
+    params._updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(world[3], 4);
+    EXPECT_EQ(ambient[1], 1);
+
+    source.setAmbientLightColour(ColourValue::Blue);
+    params._updateAutoParams(&source, GPV_ALL);
+    EXPECT_EQ(ambient[1], 0);
+    EXPECT_EQ(ambient[2], 1);
+
+    // versions of another source never match
+    params.setNamedConstant("ambient", ColourValue::Green);
+    AutoParamDataSource other;
+    other.setWorldMatrices(&transform, 1);
+    other.setAmbientLightColour(ColourValue::Blue);
+    params._updateAutoParams(&other, GPV_ALL);
+    EXPECT_EQ(ambient[1], 0);
+    EXPECT_EQ(world[3], 1);
+}
+
 TEST(Billboard, TextureCoords)
 {
     Root root("");
@@ -0,0 +1,215 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+
+#include "OgreOptimisedUtil.h"
+#include "OgreMatrix4.h"
+#include "OgreTimer.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace
+{
+/// the implementations other than General, that can run on this machine
+std::vector<std::pair<String, OptimisedUtil*>> getOptimisedImplementations()
+{
+    std::vector<std::pair<String, OptimisedUtil*>> ret;
+    for (auto isa : {"SSE", "AVX2"})
+    {
+        if (auto impl = OptimisedUtil::_getImplementation(isa))
+            ret.emplace_back(isa, impl);
+    }
+    return ret;
+}
+
+void expectNear(const float* result, const float* expected, size_t count, float tolerance = 1e-4f)
+{
+    for (size_t i = 0; i < count; i++)
+        ASSERT_NEAR(result[i], expected[i], tolerance * std::max(1.0f, std::abs(expected[i]))) << "at " << i;
+}
+
+/// vertices with interleaved positions and normals, skinned by 4 bones each
+struct OptimisedUtilData
+{
+    static const size_t NUM_MATRICES = 32;
+
+    std::vector<float> vertices; // position, normal
+    std::vector<float> positions;
+    std::vector<float> weights;
+    std::vector<uchar> indices;
+    std::vector<Affine3> matrices;
+    std::vector<const Affine3*> matrixPtrs;
+    std::vector<EdgeData::Triangle> triangles;
+    std::vector<Vector4> faceNormals;
+    size_t numVertices;
+
+    explicit OptimisedUtilData(size_t count) : numVertices(count)
+    {
+        std::minstd_rand rng(42);
+        std::uniform_real_distribution<float> coord(-10, 10);
+        std::uniform_real_distribution<float> weight(0, 1);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Vector3 pos(coord(rng), coord(rng), coord(rng));
+            Vector3 norm = Vector3(coord(rng), coord(rng), coord(rng)).normalisedCopy();
+            vertices.insert(vertices.end(), {pos.x, pos.y, pos.z, norm.x, norm.y, norm.z});
+            positions.insert(positions.end(), {pos.x, pos.y, pos.z});
+
+            float w[4] = {weight(rng), weight(rng), weight(rng), weight(rng)};
+            float sum = w[0] + w[1] + w[2] + w[3];
+            for (auto v : w)
+            {
+                weights.push_back(v / sum);
+                indices.push_back(uchar(rng() % NUM_MATRICES));
+            }
+        }
+
+        for (size_t i = 0; i < NUM_MATRICES; i++)
+        {
+            Quaternion rot(Radian(coord(rng)), Vector3(coord(rng), coord(rng), coord(rng)).normalisedCopy());
+            matrices.push_back(Affine3(Vector3(coord(rng), coord(rng), coord(rng)), rot));
+        }
+        for (auto& m : matrices)
+            matrixPtrs.push_back(&m);
+
+        triangles.resize(count);
+        for (auto& t : triangles)
+        {
+            for (auto& idx : t.vertIndex)
+                idx = uint32(rng() % count);
+        }
+        faceNormals.resize(count);
+        OptimisedUtil::_getImplementation("General")->calculateFaceNormals(positions.data(), triangles.data(),
+                                                                           faceNormals.data(), count);
+    }
+
+    void skin(OptimisedUtil* impl, float* dest, bool normals) const
+    {
+        impl->softwareVertexSkinning(vertices.data(), dest, normals ? vertices.data() + 3 : NULL, dest + 3,
+                                     weights.data(), indices.data(), matrixPtrs.data(), 24, 24, 24, 24, 16, 4, 4,
+                                     numVertices);
+    }
+};
+} // namespace
+
+TEST(OptimisedUtil, MatchesGeneral)
+{
+    // not a multiple of the vector width, so the remainders are tested too
+    OptimisedUtilData data(1003);
+    size_t count = data.numVertices;
+    OptimisedUtil* general = OptimisedUtil::_getImplementation("General");
+    ASSERT_TRUE(general);
+
+    const Vector4 lights[] = {Vector4(1, 2, 3, 1), Vector4(0.3f, -0.5f, 0.8f, 0)};
+
+    for (auto& impl : getOptimisedImplementations())
+    {
+        SCOPED_TRACE(impl.first);
+        // SSE normalises using the reciprocal square root estimate
+        float normTolerance = impl.first == "SSE" ? 1e-3f : 1e-4f;
+        std::vector<float> expected(count * 6), result(count * 6);
+
+        for (bool normals : {false, true})
+        {
+            data.skin(general, expected.data(), normals);
+            data.skin(impl.second, result.data(), normals);
+            expectNear(result.data(), expected.data(), result.size(), normals ? normTolerance : 1e-4f);
+        }
+
+        // packed positions and interleaved with normals
+        for (size_t vsize : {12, 24})
+        {
+            bool normals = vsize == 24;
+            const float* src1 = normals ? data.vertices.data() : data.positions.data();
+            const float* src2 = src1 + vsize / sizeof(float);
+            general->softwareVertexMorph(0.3f, src1, src2, expected.data(), vsize, vsize, vsize, count - 1, normals);
+            impl.second->softwareVertexMorph(0.3f, src1, src2, result.data(), vsize, vsize, vsize, count - 1,
+                                             normals);
+            expectNear(result.data(), expected.data(), (count - 1) * vsize / sizeof(float),
+                       normals ? normTolerance : 1e-4f);
+        }
+
+        std::vector<Affine3> expectedMat(data.matrices.size()), resultMat(data.matrices.size());
+        general->concatenateAffineMatrices(data.matrices[0], data.matrices.data(), expectedMat.data(),
+                                           data.matrices.size());
+        impl.second->concatenateAffineMatrices(data.matrices[0], data.matrices.data(), resultMat.data(),
+                                               data.matrices.size());
+        // the last row is implicit
+        for (size_t i = 0; i < resultMat.size(); i++)
+            expectNear(resultMat[i][0], expectedMat[i][0], 12);
+
+        std::vector<Vector4> faceNormals(count);
+        impl.second->calculateFaceNormals(data.positions.data(), data.triangles.data(), faceNormals.data(), count);
+        expectNear(faceNormals[0].ptr(), data.faceNormals[0].ptr(), count * 4);
+
+        for (const auto& light : lights)
+        {
+            std::vector<char> expectedFacing(count), resultFacing(count);
+            general->calculateLightFacing(light, data.faceNormals.data(), expectedFacing.data(), count);
+            impl.second->calculateLightFacing(light, data.faceNormals.data(), resultFacing.data(), count);
+            EXPECT_EQ(resultFacing, expectedFacing);
+
+            general->extrudeVertices(light, 100, data.positions.data(), expected.data(), count);
+            impl.second->extrudeVertices(light, 100, data.positions.data(), result.data(), count);
+            expectNear(result.data(), expected.data(), count * 3, normTolerance);
+        }
+    }
+}
+
+TEST(OptimisedUtil, Benchmark)
+{
+    OptimisedUtilData data(10000);
+    size_t count = data.numVertices;
+    const int iterations = 100;
+
+    auto impls = getOptimisedImplementations();
+    impls.emplace(impls.begin(), "General", OptimisedUtil::_getImplementation("General"));
+
+    std::vector<float> dest(count * 6);
+    std::vector<Affine3> matrices(data.matrices.size());
+    std::vector<char> facings(count);
+
+    for (auto& impl : impls)
+    {
+        OptimisedUtil* util = impl.second;
+        Timer timer;
+        auto elapsed = [&timer]() {
+            auto ret = timer.getMicroseconds() / double(iterations);
+            timer.reset();
+            return ret;
+        };
+
+        timer.reset();
+        for (int i = 0; i < iterations; i++)
+            data.skin(util, dest.data(), true);
+        auto skinning = elapsed();
+        for (int i = 0; i < iterations; i++)
+            util->softwareVertexMorph(0.3f, data.vertices.data(), data.vertices.data() + 6, dest.data(), 24, 24, 24,
+                                      count - 1, true);
+        auto morph = elapsed();
+        for (int i = 0; i < iterations * 100; i++)
+            util->concatenateAffineMatrices(data.matrices[0], data.matrices.data(), matrices.data(),
+                                            matrices.size());
+        auto concatenate = elapsed() / 100;
+        for (int i = 0; i < iterations; i++)
+            util->calculateFaceNormals(data.positions.data(), data.triangles.data(), data.faceNormals.data(), count);
+        auto faceNormals = elapsed();
+        for (int i = 0; i < iterations; i++)
+            util->calculateLightFacing(Vector4(1, 2, 3, 1), data.faceNormals.data(), facings.data(), count);
+        auto lightFacing = elapsed();
+        for (int i = 0; i < iterations; i++)
+            util->extrudeVertices(Vector4(1, 2, 3, 1), 100, data.positions.data(), dest.data(), count);
+        auto extrude = elapsed();
+
+        printf("%-7s %zu vertices: skinning %.1fus, morph %.1fus, face normals %.1fus, light facing %.1fus, "
+               "point light extrusion %.1fus; %zu matrices concatenated %.2fus\n",
+               impl.first.c_str(), count, skinning, morph, faceNormals, lightFacing, extrude, matrices.size(),
+               concatenate);
+    }
+}
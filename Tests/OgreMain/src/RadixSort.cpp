@@ -203,5 +203,24 @@ TEST_F(RadixSortTests,IntVector)
     }
 }
 //--------------------------------------------------------------------------
+TEST_F(RadixSortTests,Uint64VectorStable)
+{
+    typedef std::pair<uint64, int> Item;
+    std::vector<Item> container;
+    RadixSort<std::vector<Item>, Item, uint64> sorter;
 
+    // few distinct values in the upper and lower half, so the order of equal keys matters
+    for (int i = 0; i < 1000; ++i)
+    {
+        uint64 key = (uint64(rand() % 16) << 40) | uint64(rand() % 16) | 0xFF000000;
+        container.push_back(Item(key, i));
+    }
 
+    std::vector<Item> expected = container;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const Item& a, const Item& b) { return a.first < b.first; });
+
+    sorter.sort(container, [](const Item& p) { return p.first; });
+    EXPECT_EQ(container, expected);
+}
+//--------------------------------------------------------------------------
@@ -0,0 +1,641 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+
+#include "RootWithoutRenderSystemFixture.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreEntity.h"
+#include "OgreMeshManager.h"
+#include "OgreCamera.h"
+#include "OgreWorkQueue.h"
+#include "OgreFrameTaskGraph.h"
+#include "OgreTimer.h"
+#include "OgreRenderQueue.h"
+#include "OgreRenderQueueSortingGrouping.h"
+#include "OgreSubEntity.h"
+#include "OgreMaterialManager.h"
+#include "OgreTechnique.h"
+#include "OgrePass.h"
+
+#include <random>
+#include <thread>
+
+using namespace Ogre;
+
+namespace
+{
+// creates the same pseudo random hierarchy in every SceneManager passed
+struct HierarchyBuilder
+{
+    std::vector<SceneManager*> managers;
+    std::minstd_rand rng;
+
+    Real random(Real min, Real max) { return min + (max - min) * Real(rng()) / rng.max(); }
+
+    void transform(std::vector<SceneNode*>& nodes)
+    {
+        Vector3 pos(random(-100, 100), random(-100, 100), random(-100, 100));
+        Quaternion rot(Degree(random(0, 360)), Vector3(random(-1, 1), random(-1, 1), 1).normalisedCopy());
+        Vector3 scale(random(0.95, 1.05), random(0.95, 1.05), random(0.95, 1.05));
+        for (auto n : nodes)
+        {
+            n->setPosition(pos);
+            n->setOrientation(rot);
+            n->setScale(scale);
+        }
+    }
+
+    std::vector<SceneNode*> createChildren(const std::vector<SceneNode*>& parents, bool withEntity)
+    {
+        std::vector<SceneNode*> children;
+        for (size_t i = 0; i < managers.size(); i++)
+        {
+            children.push_back(parents[i]->createChildSceneNode());
+            if (withEntity)
+                children.back()->attachObject(managers[i]->createEntity(SceneManager::PT_CUBE));
+        }
+        transform(children);
+        return children;
+    }
+
+    std::vector<SceneNode*> roots()
+    {
+        std::vector<SceneNode*> ret;
+        for (auto sm : managers)
+            ret.push_back(sm->getRootSceneNode());
+        return ret;
+    }
+
+    /// few subtrees with many children each
+    void createWide(size_t subtrees, size_t childrenPerSubtree)
+    {
+        for (size_t s = 0; s < subtrees; s++)
+        {
+            auto subtree = createChildren(roots(), false);
+            for (size_t c = 0; c < childrenPerSubtree; c++)
+                createChildren(subtree, true);
+        }
+    }
+
+    /// long chains of nodes
+    void createDeep(size_t chains, size_t depth)
+    {
+        for (size_t c = 0; c < chains; c++)
+        {
+            auto parents = roots();
+            for (size_t d = 0; d < depth; d++)
+                parents = createChildren(parents, true);
+        }
+    }
+};
+
+void expectSameSceneGraph(const SceneNode* a, const SceneNode* b)
+{
+    ASSERT_EQ(a->getChildren().size(), b->getChildren().size());
+    EXPECT_EQ(a->_getDerivedPosition(), b->_getDerivedPosition());
+    EXPECT_EQ(a->_getDerivedOrientation(), b->_getDerivedOrientation());
+    EXPECT_EQ(a->_getDerivedScale(), b->_getDerivedScale());
+    EXPECT_EQ(a->_getWorldAABB(), b->_getWorldAABB());
+
+    for (size_t i = 0; i < a->getChildren().size(); i++)
+        expectSameSceneGraph(static_cast<const SceneNode*>(a->getChildren()[i]),
+                             static_cast<const SceneNode*>(b->getChildren()[i]));
+}
+
+struct ParallelSceneGraphTest : public RootWithoutRenderSystemFixture
+{
+    SceneManager* mSerial;
+    SceneManager* mParallel;
+    Camera* mCamera;
+    HierarchyBuilder mBuilder;
+    const char* mVariant = "parallel";
+
+    void SetUp() override
+    {
+        RootWithoutRenderSystemFixture::SetUp();
+        MeshManager::getSingleton()._initialise(); // prefab meshes
+        mRoot->getWorkQueue()->startup();
+
+        mSerial = mRoot->createSceneManager();
+        mParallel = mRoot->createSceneManager();
+        mParallel->setParallelSceneGraphUpdate(true);
+        mCamera = mSerial->createCamera("Camera");
+        mBuilder.managers = {mSerial, mParallel};
+    }
+
+    void TearDown() override
+    {
+        mRoot->getWorkQueue()->shutdown();
+        RootWithoutRenderSystemFixture::TearDown();
+    }
+
+    void update()
+    {
+        mSerial->_updateSceneGraph(mCamera);
+        mParallel->_updateSceneGraph(mCamera);
+    }
+
+    /// move some of the nodes, so only parts of the graph need updating
+    void moveSome(SceneNode* a, SceneNode* b, size_t step, size_t& counter)
+    {
+        if (counter++ % step == 0)
+        {
+            std::vector<SceneNode*> nodes = {a, b};
+            mBuilder.transform(nodes);
+        }
+
+        for (size_t i = 0; i < a->getChildren().size(); i++)
+            moveSome(static_cast<SceneNode*>(a->getChildren()[i]),
+                     static_cast<SceneNode*>(b->getChildren()[i]), step, counter);
+    }
+
+    double timeUpdate(SceneManager* sm, int iterations)
+    {
+        Timer timer;
+        for (int i = 0; i < iterations; i++)
+        {
+            // force a full update of the graph
+            sm->getRootSceneNode()->needUpdate();
+            sm->_updateSceneGraph(mCamera);
+        }
+        return timer.getMicroseconds() / 1000.0 / iterations;
+    }
+
+    void benchmark(const char* name)
+    {
+        update();
+        expectSameSceneGraph(mSerial->getRootSceneNode(), mParallel->getRootSceneNode());
+
+        int iterations = 10;
+        double serial = timeUpdate(mSerial, iterations);
+        double parallel = timeUpdate(mParallel, iterations);
+        printf("%s: serial %.3fms, %s %.3fms (%zu workers)\n", name, serial, mVariant, parallel,
+               mRoot->getWorkQueue()->getWorkerThreadCount());
+
+        expectSameSceneGraph(mSerial->getRootSceneNode(), mParallel->getRootSceneNode());
+    }
+};
+
+struct NodeTransformStoreTest : public ParallelSceneGraphTest
+{
+    void SetUp() override
+    {
+        ParallelSceneGraphTest::SetUp();
+        mParallel->setParallelSceneGraphUpdate(false);
+        mParallel->setNodeTransformStoreEnabled(true);
+        mVariant = "transform store";
+    }
+};
+
+/// records the queued renderables by pass, identified by the position of their node
+struct QueueRecorder : public QueuedRenderableVisitor
+{
+    std::vector<std::pair<const Pass*, Vector3>> items;
+
+    void add(const Pass* p, Renderable* r)
+    {
+        auto node = static_cast<SubEntity*>(r)->getParent()->getParentSceneNode();
+        items.emplace_back(p, node->_getDerivedPosition());
+    }
+    void visit(RenderablePass* rp) override { add(rp->pass, rp->renderable); }
+    void visit(const Pass* p, RenderableList& rs) override
+    {
+        for (auto r : rs)
+            add(p, r);
+    }
+};
+
+struct ParallelCullingTest : public ParallelSceneGraphTest
+{
+    Camera* mSerialCamera;
+    Camera* mParallelCamera;
+
+    void SetUp() override
+    {
+        ParallelSceneGraphTest::SetUp();
+        mParallel->setParallelSceneGraphUpdate(false);
+        mParallel->setParallelFindVisibleObjects(true);
+
+        auto nodes = mBuilder.createChildren(mBuilder.roots(), false);
+        mSerialCamera = mSerial->createCamera("Culling");
+        mParallelCamera = mParallel->createCamera("Culling");
+        nodes[0]->attachObject(mSerialCamera);
+        nodes[1]->attachObject(mParallelCamera);
+        for (auto n : nodes)
+        {
+            n->setPosition(Vector3::ZERO);
+            n->lookAt(Vector3(1, 0, -1), Node::TS_WORLD);
+        }
+        for (auto cam : {mSerialCamera, mParallelCamera})
+        {
+            cam->setNearClipDistance(1);
+            cam->setFarClipDistance(300);
+        }
+    }
+
+    void cull(SceneManager* sm, Camera* cam, QueueRecorder& recorder, VisibleObjectsBoundsInfo& bounds)
+    {
+        RenderQueue* queue = sm->getRenderQueue();
+        queue->clear();
+        bounds.reset();
+        sm->_findVisibleObjects(cam, &bounds, false);
+
+        for (const auto& group : queue->_getQueueGroups())
+        {
+            if (!group)
+                continue;
+            for (const auto& pg : group->getPriorityGroups())
+                pg.second->getSolidsBasic().acceptVisitor(&recorder, QueuedRenderableCollection::OM_PASS_GROUP);
+        }
+    }
+
+    void expectSameQueue()
+    {
+        QueueRecorder serial, parallel;
+        VisibleObjectsBoundsInfo serialBounds, parallelBounds;
+        cull(mSerial, mSerialCamera, serial, serialBounds);
+        cull(mParallel, mParallelCamera, parallel, parallelBounds);
+
+        EXPECT_FALSE(serial.items.empty());
+        EXPECT_EQ(serial.items, parallel.items);
+        EXPECT_EQ(serialBounds.aabb, parallelBounds.aabb);
+        EXPECT_EQ(serialBounds.minDistance, parallelBounds.minDistance);
+        EXPECT_EQ(serialBounds.maxDistance, parallelBounds.maxDistance);
+    }
+
+    double timeCulling(SceneManager* sm, Camera* cam, int iterations)
+    {
+        VisibleObjectsBoundsInfo bounds;
+        Timer timer;
+        for (int i = 0; i < iterations; i++)
+        {
+            sm->getRenderQueue()->clear();
+            bounds.reset();
+            sm->_findVisibleObjects(cam, &bounds, false);
+        }
+        return timer.getMicroseconds() / 1000.0 / iterations;
+    }
+};
+struct SortKeyQueueTest : public ParallelCullingTest
+{
+    std::vector<MaterialPtr> mMaterials;
+
+    void SetUp() override
+    {
+        ParallelCullingTest::SetUp();
+        mParallel->getRenderQueue()->setSortKeysEnabled(true);
+        for (auto sm : {mSerial, mParallel})
+        {
+            RenderQueueGroup* group = sm->getRenderQueue()->getQueueGroup(RENDER_QUEUE_MAIN);
+            group->addOrganisationMode(QueuedRenderableCollection::OM_PASS_GROUP);
+            group->addOrganisationMode(QueuedRenderableCollection::OM_SORT_DESCENDING);
+        }
+
+        // passes with the same hash, which are ordered by address, and with different ones
+        for (int i = 0; i < 6; i++)
+        {
+            auto mat = MaterialManager::getSingleton().create(StringUtil::format("SortKey%d", i), RGN_DEFAULT);
+            for (int j = 0; j < i % 3; j++)
+                mat->getTechnique(0)->createPass();
+            mMaterials.push_back(mat);
+        }
+    }
+
+    void TearDown() override
+    {
+        mMaterials.clear();
+        ParallelCullingTest::TearDown();
+    }
+
+    /// give the same entities of both hierarchies the same material
+    void assignMaterials(SceneNode* a, SceneNode* b, size_t& counter)
+    {
+        for (size_t i = 0; i < a->getAttachedObjects().size(); i++)
+        {
+            auto ea = dynamic_cast<Entity*>(a->getAttachedObjects()[i]);
+            auto eb = dynamic_cast<Entity*>(b->getAttachedObjects()[i]);
+            if (!ea || !eb)
+                continue;
+            auto mat = mMaterials[counter++ % mMaterials.size()];
+            ea->setMaterial(mat);
+            eb->setMaterial(mat);
+        }
+
+        for (size_t i = 0; i < a->getChildren().size(); i++)
+            assignMaterials(static_cast<SceneNode*>(a->getChildren()[i]),
+                            static_cast<SceneNode*>(b->getChildren()[i]), counter);
+    }
+
+    void record(SceneManager* sm, Camera* cam, QueuedRenderableCollection::OrganisationMode om,
+                QueueRecorder& recorder)
+    {
+        RenderQueue* queue = sm->getRenderQueue();
+        queue->clear();
+        sm->_findVisibleObjects(cam, NULL, false);
+
+        for (const auto& group : queue->_getQueueGroups())
+        {
+            if (!group)
+                continue;
+            for (const auto& pg : group->getPriorityGroups())
+            {
+                pg.second->sort(cam);
+                pg.second->getSolidsBasic().acceptVisitor(&recorder, om);
+            }
+        }
+    }
+
+    void expectSameOrder(QueuedRenderableCollection::OrganisationMode om)
+    {
+        QueueRecorder serial, sortKeys;
+        record(mSerial, mSerialCamera, om, serial);
+        record(mParallel, mParallelCamera, om, sortKeys);
+
+        // more than 2000 items, so the default sorts by pass hash on ties like the sort keys
+        EXPECT_GT(serial.items.size(), 2000u);
+        EXPECT_EQ(serial.items, sortKeys.items);
+
+    }
+
+    double timeQueue(SceneManager* sm, Camera* cam, int iterations)
+    {
+        Timer timer;
+        for (int i = 0; i < iterations; i++)
+        {
+            QueueRecorder recorder;
+            record(sm, cam, QueuedRenderableCollection::OM_PASS_GROUP, recorder);
+        }
+        return timer.getMicroseconds() / 1000.0 / iterations;
+    }
+};
+} // namespace
+
+TEST(WorkQueue, parallelFor)
+{
+    Root root("");
+    auto queue = root.getWorkQueue();
+    queue->startup();
+
+    std::vector<int> visited(1000);
+    queue->parallelFor(10, visited.size(), [&visited](size_t i) { visited[i]++; }, 7);
+    for (size_t i = 0; i < visited.size(); i++)
+        EXPECT_EQ(visited[i], i < 10 ? 0 : 1);
+
+    // everything runs on the calling thread, if workers are not available
+    queue->setPaused(true);
+    queue->parallelFor(0, visited.size(), [&visited](size_t i) { visited[i]++; });
+    queue->setPaused(false);
+    EXPECT_EQ(visited[0], 1);
+    EXPECT_EQ(visited.back(), 2);
+
+    queue->shutdown();
+}
+
+TEST(WorkQueue, TaskPriorities)
+{
+    Root root("");
+    auto queue = root.getWorkQueue();
+    queue->setWorkerThreadCount(1);
+    queue->startup();
+
+    // keep the only worker busy, until everything is queued
+    std::atomic<bool> started(false), released(false);
+    queue->addTask([&]() {
+        started = true;
+        while (!released)
+            std::this_thread::yield();
+    });
+    while (!started)
+        std::this_thread::yield();
+
+    std::vector<int> order;
+    std::mutex orderMutex;
+    std::atomic<int> pending(9);
+    for (int i = 0; i < 3; i++)
+    {
+        for (auto priority : {WorkQueue::TP_LOW, WorkQueue::TP_NORMAL, WorkQueue::TP_HIGH})
+        {
+            queue->addTask(
+                [&, priority]() {
+                    std::lock_guard<std::mutex> lock(orderMutex);
+                    order.push_back(priority);
+                    --pending;
+                },
+                priority);
+        }
+    }
+    released = true;
+    while (pending)
+        std::this_thread::yield();
+
+    std::vector<int> expected = {2, 2, 2, 1, 1, 1, 0, 0, 0};
+    EXPECT_EQ(order, expected);
+
+    // tasks added by the workers themselves all complete as well
+    queue->setWorkerThreadCount(4);
+    queue->startup(true);
+    std::atomic<int> done(0);
+    for (int i = 0; i < 100; i++)
+        queue->addTask([&]() {
+            for (int j = 0; j < 10; j++)
+                queue->addTask([&]() { ++done; });
+        });
+    while (done < 1000)
+        std::this_thread::yield();
+
+    queue->shutdown();
+}
+
+TEST(FrameTaskGraph, Dependencies)
+{
+    Root root("");
+    auto queue = root.getWorkQueue();
+    queue->setWorkerThreadCount(2);
+    queue->startup();
+
+    auto graph = root.getFrameTaskGraph();
+    auto animations = graph->findJob("SceneAnimations");
+
+    // the position in which every job completed
+    std::atomic<int> counter(0);
+    std::vector<int> completed(5);
+    auto job = [&](int i) {
+        return [&, i]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            completed[i] = ++counter;
+        };
+    };
+    auto a = graph->addJob("a", job(0), {animations});
+    auto b = graph->addJob("b", job(1), {a});
+    auto c = graph->addJob("c", job(2), {a});
+    auto d = graph->addJob("d", job(3), {b, c});
+    auto mainThread = OGRE_THREAD_CURRENT_ID;
+    auto e = graph->addJob("e", [&]() {
+        EXPECT_EQ(OGRE_THREAD_CURRENT_ID, mainThread);
+        job(4)();
+    }, {a}, true);
+    EXPECT_EQ(graph->getNumJobs(), 7u);
+
+    for (bool paused : {false, true})
+    {
+        queue->setPaused(paused);
+        counter = 0;
+        graph->run(queue);
+        EXPECT_EQ(counter, 5);
+        EXPECT_LT(completed[0], completed[1]);
+        EXPECT_LT(completed[0], completed[2]);
+        EXPECT_LT(completed[0], completed[4]);
+        EXPECT_LT(completed[1], completed[3]);
+        EXPECT_LT(completed[2], completed[3]);
+        EXPECT_GT(graph->getJobDuration(d), 0u);
+    }
+    queue->setPaused(false);
+
+    // exceptions are passed on after all jobs ran
+    graph->removeJob(e);
+    EXPECT_THROW(graph->findJob("e"), ItemIdentityException);
+    graph->addJob("throws", []() { OGRE_EXCEPT(Exception::ERR_INVALID_STATE, "failed"); }, {c});
+    counter = 0;
+    EXPECT_THROW(graph->run(queue), InvalidStateException);
+    EXPECT_EQ(counter, 4);
+
+    queue->shutdown();
+}
+
+TEST_F(ParallelSceneGraphTest, SameAsSerial)
+{
+    mBuilder.createWide(3, 50);
+    mBuilder.createDeep(2, 20);
+    update();
+    expectSameSceneGraph(mSerial->getRootSceneNode(), mParallel->getRootSceneNode());
+
+    // partial updates only touch the nodes marked as changed
+    size_t counter = 1;
+    moveSome(mSerial->getRootSceneNode(), mParallel->getRootSceneNode(), 7, counter);
+    update();
+    expectSameSceneGraph(mSerial->getRootSceneNode(), mParallel->getRootSceneNode());
+
+    // no changes at all
+    update();
+    expectSameSceneGraph(mSerial->getRootSceneNode(), mParallel->getRootSceneNode());
+}
+
+TEST_F(ParallelSceneGraphTest, WideBenchmark)
+{
+    mBuilder.createWide(4, 2500);
+    benchmark("wide hierarchy");
+}
+
+TEST_F(ParallelSceneGraphTest, DeepBenchmark)
+{
+    mBuilder.createDeep(50, 200);
+    benchmark("deep hierarchy");
+}
+
+TEST_F(NodeTransformStoreTest, SameAsSerial)
+{
+    mBuilder.createWide(3, 50);
+    mBuilder.createDeep(2, 20);
+    update();
+    expectSameSceneGraph(mSerial->getRootSceneNode(), mParallel->getRootSceneNode());
+
+    size_t counter = 1;
+    moveSome(mSerial->getRootSceneNode(), mParallel->getRootSceneNode(), 7, counter);
+    update();
+    expectSameSceneGraph(mSerial->getRootSceneNode(), mParallel->getRootSceneNode());
+
+    // the store is rebuilt after the hierarchy changed
+    for (auto sm : mBuilder.managers)
+    {
+        auto root = sm->getRootSceneNode();
+        auto moved = static_cast<SceneNode*>(root->getChild(0)->getChild(0));
+        moved->getParent()->removeChild(moved);
+        root->getChild(1)->addChild(moved);
+        sm->destroySceneNode(static_cast<SceneNode*>(root->getChild(2)->getChild(3)));
+    }
+    mBuilder.createDeep(1, 5);
+    update();
+    expectSameSceneGraph(mSerial->getRootSceneNode(), mParallel->getRootSceneNode());
+
+    // depth levels processed on the WorkQueue
+    mParallel->setParallelSceneGraphUpdate(true);
+    moveSome(mSerial->getRootSceneNode(), mParallel->getRootSceneNode(), 3, counter);
+    update();
+    expectSameSceneGraph(mSerial->getRootSceneNode(), mParallel->getRootSceneNode());
+}
+
+TEST_F(NodeTransformStoreTest, WideBenchmark)
+{
+    mBuilder.createWide(4, 2500);
+    benchmark("wide hierarchy");
+}
+
+TEST_F(NodeTransformStoreTest, DeepBenchmark)
+{
+    mBuilder.createDeep(50, 200);
+    benchmark("deep hierarchy");
+}
+
+TEST_F(ParallelCullingTest, SameAsSerial)
+{
+    mBuilder.createWide(3, 100);
+    mBuilder.createDeep(4, 20);
+    update();
+    expectSameQueue();
+
+    // culling again reuses the fragments
+    size_t counter = 1;
+    moveSome(mSerial->getRootSceneNode(), mParallel->getRootSceneNode(), 5, counter);
+    update();
+    expectSameQueue();
+}
+
+TEST_F(ParallelCullingTest, Benchmark)
+{
+    mBuilder.createWide(4, 2500);
+    update();
+    expectSameQueue();
+
+    int iterations = 10;
+    double serial = timeCulling(mSerial, mSerialCamera, iterations);
+    double parallel = timeCulling(mParallel, mParallelCamera, iterations);
+    printf("culling: serial %.3fms, parallel %.3fms (%zu workers)\n", serial, parallel,
+           mRoot->getWorkQueue()->getWorkerThreadCount());
+}
+
+TEST_F(SortKeyQueueTest, SameOrder)
+{
+    mBuilder.createWide(4, 1500);
+    size_t counter = 0;
+    assignMaterials(mSerial->getRootSceneNode(), mParallel->getRootSceneNode(), counter);
+    update();
+
+    expectSameOrder(QueuedRenderableCollection::OM_PASS_GROUP);
+    expectSameOrder(QueuedRenderableCollection::OM_SORT_DESCENDING);
+    expectSameOrder(QueuedRenderableCollection::OM_SORT_ASCENDING);
+
+    // filling the queue again reuses the lists
+    counter = 1;
+    moveSome(mSerial->getRootSceneNode(), mParallel->getRootSceneNode(), 3, counter);
+    update();
+    expectSameOrder(QueuedRenderableCollection::OM_PASS_GROUP);
+    expectSameOrder(QueuedRenderableCollection::OM_SORT_DESCENDING);
+}
+
+TEST_F(SortKeyQueueTest, Benchmark)
+{
+    mParallel->setParallelFindVisibleObjects(false);
+    mBuilder.createWide(4, 2500);
+    size_t counter = 0;
+    assignMaterials(mSerial->getRootSceneNode(), mParallel->getRootSceneNode(), counter);
+    update();
+
+    int iterations = 10;
+    double pass = timeQueue(mSerial, mSerialCamera, iterations);
+    double keys = timeQueue(mParallel, mParallelCamera, iterations);
+    printf("render queue: pass map %.3fms, sort keys %.3fms\n", pass, keys);
+}
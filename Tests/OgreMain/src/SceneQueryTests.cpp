@@ -0,0 +1,366 @@
+// This file is part of the OGRE project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at https://www.ogre3d.org/licensing.
+// SPDX-License-Identifier: MIT
+
+#include <gtest/gtest.h>
+
+#include "RootWithoutRenderSystemFixture.h"
+#include "OgreSceneManager.h"
+#include "OgreSceneNode.h"
+#include "OgreEntity.h"
+#include "OgreManualObject.h"
+#include "OgreMeshManager.h"
+#include "OgreCamera.h"
+#include "OgreTimer.h"
+
+#include <random>
+
+using namespace Ogre;
+
+namespace Ogre
+{
+static bool operator==(const RaySceneQueryResultEntry& a, const RaySceneQueryResultEntry& b)
+{
+    return a.distance == b.distance && a.movable == b.movable && a.worldFragment == b.worldFragment;
+}
+} // namespace Ogre
+
+namespace
+{
+typedef std::vector<std::pair<MovableObject*, MovableObject*>> PairList;
+
+struct PairRecorder : public IntersectionSceneQueryListener
+{
+    PairList pairs;
+    size_t limit = std::numeric_limits<size_t>::max();
+
+    bool queryResult(MovableObject* first, MovableObject* second) override
+    {
+        pairs.emplace_back(first, second);
+        return pairs.size() < limit;
+    }
+    bool queryResult(MovableObject*, SceneQuery::WorldFragment*) override { return true; }
+};
+
+/// compares all pairs of objects, like the scene query did before using a broadphase
+PairList bruteForcePairs(SceneManager* sm, uint32 typeMask)
+{
+    std::vector<MovableObject*> objects;
+    for (const auto& f : Root::getSingleton().getMovableObjectFactories())
+    {
+        for (const auto& o : sm->getMovableObjects(f.first))
+        {
+            if (!(o.second->getTypeFlags() & typeMask))
+                break;
+            if (o.second->isInScene())
+                objects.push_back(o.second);
+        }
+    }
+
+    PairList pairs;
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        for (size_t j = i + 1; j < objects.size(); j++)
+        {
+            if (objects[i]->getWorldBoundingBox().intersects(objects[j]->getWorldBoundingBox()))
+                pairs.emplace_back(objects[i], objects[j]);
+        }
+    }
+    return pairs;
+}
+
+struct IntersectionQueryTest : public RootWithoutRenderSystemFixture
+{
+    SceneManager* mSceneMgr;
+    Camera* mCamera;
+    std::vector<SceneNode*> mNodes;
+    std::mt19937 mRng{42};
+    /// half size of the volume the cubes were created in
+    Real mExtent = 0;
+
+    void SetUp() override
+    {
+        RootWithoutRenderSystemFixture::SetUp();
+        MeshManager::getSingleton()._initialise();
+
+        mSceneMgr = mRoot->createSceneManager();
+        mCamera = mSceneMgr->createCamera("Camera");
+        mSceneMgr->getRootSceneNode()->attachObject(mCamera);
+    }
+
+    /// create count cubes, so that every cube overlaps about density others
+    void createCubes(size_t count, Real density = 2)
+    {
+        // prefab cubes are 100 units wide
+        Real extent = 100 * std::cbrt(count / density) / 2;
+        mExtent = std::max(mExtent, extent);
+        std::uniform_real_distribution<Real> pos(-extent, extent);
+        std::uniform_real_distribution<Real> scale(0.5, 1.5);
+        for (size_t i = 0; i < count; i++)
+        {
+            auto node = mSceneMgr->getRootSceneNode()->createChildSceneNode(
+                Vector3(pos(mRng), pos(mRng), pos(mRng)));
+            node->setScale(Vector3(scale(mRng), scale(mRng), scale(mRng)) / 2);
+            node->attachObject(mSceneMgr->createEntity(SceneManager::PT_CUBE));
+            mNodes.push_back(node);
+        }
+        mSceneMgr->_updateSceneGraph(mCamera);
+    }
+
+    void moveCubes(Real distance)
+    {
+        std::uniform_real_distribution<Real> offset(-distance, distance);
+        for (auto n : mNodes)
+            n->translate(offset(mRng), offset(mRng), offset(mRng));
+        mSceneMgr->_updateSceneGraph(mCamera);
+    }
+
+    PairList execute(IntersectionSceneQuery* query)
+    {
+        PairRecorder recorder;
+        query->execute(&recorder);
+        return recorder.pairs;
+    }
+
+    void benchmark(size_t count)
+    {
+        createCubes(count);
+        auto query = mSceneMgr->createIntersectionQuery();
+
+        Timer timer;
+        size_t numPairs = execute(query).size();
+        auto first = timer.getMicroseconds();
+
+        moveCubes(5);
+        timer.reset();
+        execute(query);
+        auto update = timer.getMicroseconds();
+
+        printf("intersection query of %zu objects (%zu pairs): first %.3fms, after moving %.3fms", count,
+               numPairs, first / 1000.0, update / 1000.0);
+        if (count <= 10000)
+        {
+            timer.reset();
+            bruteForcePairs(mSceneMgr, query->getQueryTypeMask());
+            printf(", brute force %.3fms", timer.getMicroseconds() / 1000.0);
+        }
+        printf("\n");
+
+        mSceneMgr->destroyQuery(query);
+    }
+};
+
+typedef std::vector<RaySceneQueryResult> RayResults;
+
+/// tests the ray against all objects, like the scene query did before using a hierarchy
+RaySceneQueryResult bruteForceHits(SceneManager* sm, const Ray& ray, uint32 typeMask)
+{
+    RaySceneQueryResult hits;
+    for (const auto& f : Root::getSingleton().getMovableObjectFactories())
+    {
+        for (const auto& o : sm->getMovableObjects(f.first))
+        {
+            if (!(o.second->getTypeFlags() & typeMask))
+                break;
+            auto hit = ray.intersects(o.second->getWorldBoundingBox());
+            if (o.second->isInScene() && hit.first)
+                hits.push_back({hit.second, o.second, NULL});
+        }
+    }
+    return hits;
+}
+
+/// order hits at the same distance too, so results can be compared
+void sortHits(RaySceneQueryResult& hits)
+{
+    std::sort(hits.begin(), hits.end(), [](const RaySceneQueryResultEntry& a, const RaySceneQueryResultEntry& b) {
+        return a.distance < b.distance || (a.distance == b.distance && a.movable < b.movable);
+    });
+}
+
+std::vector<Real> getDistances(const RaySceneQueryResult& hits)
+{
+    std::vector<Real> distances;
+    for (const auto& hit : hits)
+        distances.push_back(hit.distance);
+    return distances;
+}
+
+struct RayQueryTest : public IntersectionQueryTest
+{
+    /// rays from outside the cubes through the volume they are in, and some along the axes
+    std::vector<Ray> createRays(size_t count)
+    {
+        std::uniform_real_distribution<Real> pos(-mExtent, mExtent);
+        std::vector<Ray> rays;
+        for (size_t i = 0; i < count; i++)
+        {
+            Vector3 target(pos(mRng), pos(mRng), pos(mRng));
+            Vector3 origin = Vector3(pos(mRng), pos(mRng), pos(mRng)).normalisedCopy() * mExtent * 3;
+            if (i % 4 == 0)
+                rays.emplace_back(target, Vector3::UNIT_X);
+            else
+                rays.emplace_back(origin, (target - origin).normalisedCopy());
+        }
+        return rays;
+    }
+
+    /// check single and batched queries against brute force, unsorted and limited
+    void checkRays(RaySceneQuery* query, const std::vector<Ray>& rays)
+    {
+        RayResults batch;
+        query->setSortByDistance(false);
+        query->execute(rays, batch);
+        ASSERT_EQ(batch.size(), rays.size());
+        for (size_t i = 0; i < rays.size(); i++)
+        {
+            auto expected = bruteForceHits(mSceneMgr, rays[i], query->getQueryTypeMask());
+            sortHits(expected);
+
+            query->setRay(rays[i]);
+            auto single = query->execute();
+            sortHits(single);
+            EXPECT_EQ(single, expected);
+            sortHits(batch[i]);
+            EXPECT_EQ(batch[i], expected);
+        }
+
+        query->setSortByDistance(true, 3);
+        query->execute(rays, batch);
+        for (size_t i = 0; i < rays.size(); i++)
+        {
+            auto expected = getDistances(bruteForceHits(mSceneMgr, rays[i], query->getQueryTypeMask()));
+            std::sort(expected.begin(), expected.end());
+            expected.resize(std::min<size_t>(expected.size(), 3));
+
+            query->setRay(rays[i]);
+            EXPECT_EQ(getDistances(query->execute()), expected);
+            EXPECT_EQ(getDistances(batch[i]), expected);
+        }
+    }
+};
+} // namespace
+
+TEST_F(IntersectionQueryTest, SameAsBruteForce)
+{
+    createCubes(2000);
+
+    // objects with null and infinite bounds
+    auto node = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+    node->attachObject(mSceneMgr->createManualObject());
+    auto infinite = mSceneMgr->createManualObject();
+    infinite->setBoundingBox(AxisAlignedBox::BOX_INFINITE);
+    node->attachObject(infinite);
+    mSceneMgr->_updateSceneGraph(mCamera);
+
+    auto query = mSceneMgr->createIntersectionQuery();
+    auto expected = bruteForcePairs(mSceneMgr, query->getQueryTypeMask());
+    EXPECT_EQ(execute(query), expected);
+
+    // the listener stops the query
+    PairRecorder recorder;
+    recorder.limit = 10;
+    query->execute(&recorder);
+    EXPECT_EQ(recorder.pairs, PairList(expected.begin(), expected.begin() + 10));
+
+    // small moves only refit the hierarchy
+    moveCubes(10);
+    EXPECT_EQ(execute(query), bruteForcePairs(mSceneMgr, query->getQueryTypeMask()));
+
+    // large moves degrade it, so it is built again
+    moveCubes(1000);
+    EXPECT_EQ(execute(query), bruteForcePairs(mSceneMgr, query->getQueryTypeMask()));
+
+    // removed and added objects
+    for (size_t i = 0; i < mNodes.size(); i += 3)
+        mNodes[i]->detachAllObjects();
+    for (size_t i = 1; i < mNodes.size(); i += 3)
+        mSceneMgr->destroyEntity(static_cast<Entity*>(mNodes[i]->detachObject((unsigned short)0)));
+    mSceneMgr->destroyManualObject(infinite);
+    createCubes(100);
+    EXPECT_EQ(execute(query), bruteForcePairs(mSceneMgr, query->getQueryTypeMask()));
+
+    mSceneMgr->destroyQuery(query);
+}
+
+TEST_F(IntersectionQueryTest, Benchmark1k) { benchmark(1000); }
+TEST_F(IntersectionQueryTest, Benchmark10k) { benchmark(10000); }
+TEST_F(IntersectionQueryTest, Benchmark100k) { benchmark(100000); }
+
+TEST_F(RayQueryTest, SameAsBruteForce)
+{
+    createCubes(2000);
+
+    // objects with null and infinite bounds
+    auto node = mSceneMgr->getRootSceneNode()->createChildSceneNode();
+    node->attachObject(mSceneMgr->createManualObject());
+    auto infinite = mSceneMgr->createManualObject();
+    infinite->setBoundingBox(AxisAlignedBox::BOX_INFINITE);
+    node->attachObject(infinite);
+    mSceneMgr->_updateSceneGraph(mCamera);
+
+    auto query = mSceneMgr->createRayQuery(Ray());
+    auto rays = createRays(50);
+    checkRays(query, rays);
+
+    // the ray set on the query is kept by batches
+    query->setRay(rays[1]);
+    RayResults results;
+    query->execute(rays, results);
+    EXPECT_EQ(query->getRay().getOrigin(), rays[1].getOrigin());
+
+    // small moves only refit the hierarchy
+    moveCubes(10);
+    checkRays(query, rays);
+
+    // large moves degrade it, so it is built again
+    moveCubes(1000);
+    checkRays(query, createRays(50));
+
+    // removed and added objects
+    for (size_t i = 0; i < mNodes.size(); i += 3)
+        mNodes[i]->detachAllObjects();
+    for (size_t i = 1; i < mNodes.size(); i += 3)
+        mSceneMgr->destroyEntity(static_cast<Entity*>(mNodes[i]->detachObject((unsigned short)0)));
+    mSceneMgr->destroyManualObject(infinite);
+    createCubes(100);
+    checkRays(query, createRays(50));
+
+    mSceneMgr->destroyQuery(query);
+}
+
+TEST_F(RayQueryTest, Benchmark100k)
+{
+    createCubes(100000);
+    auto query = mSceneMgr->createRayQuery(Ray());
+    query->setSortByDistance(true, 1);
+    auto rays = createRays(1000);
+
+    // the scene is searched completely for every single query, so only time a few of them
+    const size_t numSingle = 20;
+    Timer timer;
+    for (size_t i = 0; i < numSingle; i++)
+        bruteForceHits(mSceneMgr, rays[i], query->getQueryTypeMask());
+    auto bruteForce = timer.getMicroseconds();
+
+    RayResults results;
+    query->execute(rays, results); // build the hierarchy
+    timer.reset();
+    for (size_t i = 0; i < numSingle; i++)
+    {
+        query->setRay(rays[i]);
+        query->execute();
+    }
+    auto single = timer.getMicroseconds();
+
+    timer.reset();
+    query->execute(rays, results);
+    auto batch = timer.getMicroseconds();
+
+    printf("nearest hit against 100000 objects: brute force %.3fms per ray, single query %.3fms per ray, batch "
+           "of %zu rays %.3fms per ray\n",
+           bruteForce / 1000.0 / numSingle, single / 1000.0 / numSingle, rays.size(), batch / 1000.0 / rays.size());
+
+    mSceneMgr->destroyQuery(query);
+}
@@ -28,8 +28,12 @@ THE SOFTWARE.
 #include "ZipArchiveTests.h"
 #include "Threading/OgreThreadHeaders.h"
 #include "OgreCommon.h"
+#include "OgreException.h"
 #include "OgreConfigFile.h"
 #include "OgreFileSystemLayer.h"
+#include "OgreTimer.h"
+#include <zip.h>
+#include <thread>
 
 using namespace Ogre;
 
@@ -250,3 +254,118 @@ TEST_F(ZipArchiveTests,ReadInterleave)
     EXPECT_TRUE(stream2->eof());
 }
 //--------------------------------------------------------------------------
+TEST_F(ZipArchiveTests,MemoryMapped)
+{
+    ZipArchiveFactory factory;
+    ZipArchiveFactory::setUseMemoryMapping(true);
+    Archive* mapped = factory.createInstance(arch->getName(), true);
+    ZipArchiveFactory::setUseMemoryMapping(false);
+    mapped->load();
+
+    FileInfoListPtr expected = arch->listFileInfo(true);
+    FileInfoListPtr actual = mapped->listFileInfo(true);
+    ASSERT_EQ(expected->size(), actual->size());
+    for (size_t i = 0; i < expected->size(); i++)
+    {
+        EXPECT_EQ(expected->at(i).filename, actual->at(i).filename);
+        EXPECT_EQ(expected->at(i).compressedSize, actual->at(i).compressedSize);
+        EXPECT_EQ(expected->at(i).uncompressedSize, actual->at(i).uncompressedSize);
+        EXPECT_EQ(arch->open(expected->at(i).filename)->getAsString(),
+                  mapped->open(actual->at(i).filename)->getAsString());
+    }
+    EXPECT_EQ(arch->list(true, true)->size(), mapped->list(true, true)->size());
+    EXPECT_THROW(mapped->open("missing.txt"), FileNotFoundException);
+
+    factory.destroyInstance(mapped);
+}
+//--------------------------------------------------------------------------
+TEST_F(ZipArchiveTests,MemoryMappedStoredEntry)
+{
+    String path = "StoredEntry.zip";
+    String contents = "this entry is stored without compression";
+    zip_t* zip = zip_open(path.c_str(), 0, 'w');
+    zip_entry_open(zip, "stored.txt", 1);
+    zip_entry_write(zip, contents.data(), contents.size());
+    zip_entry_close(zip);
+    zip_close(zip);
+
+    ZipArchiveFactory factory;
+    ZipArchiveFactory::setUseMemoryMapping(true);
+    Archive* mapped = factory.createInstance(path, true);
+    ZipArchiveFactory::setUseMemoryMapping(false);
+    mapped->load();
+
+    // stored entries are read-only views, which keep the mapping alive
+    DataStreamPtr stream = mapped->open("stored.txt");
+    factory.destroyInstance(mapped);
+    EXPECT_FALSE(stream->isWriteable());
+    EXPECT_EQ(contents, stream->getAsString());
+
+    stream.reset();
+    std::remove(path.c_str());
+}
+//--------------------------------------------------------------------------
+static void benchmarkOpen(const String& path, const StringVector& names, bool mapped)
+{
+    ZipArchiveFactory factory;
+    ZipArchiveFactory::setUseMemoryMapping(mapped);
+    Archive* zip = factory.createInstance(path, true);
+    ZipArchiveFactory::setUseMemoryMapping(false);
+    zip->load();
+
+    size_t maxThreads = std::max(4u, std::thread::hardware_concurrency());
+    for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+    {
+        std::vector<size_t> bytes(numThreads);
+        Timer timer;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < numThreads; t++)
+        {
+            threads.emplace_back([&, t]() {
+                for (size_t i = t; i < names.size(); i += numThreads)
+                    bytes[t] += zip->open(names[i])->size();
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        double seconds = timer.getMicroseconds() / 1e6;
+
+        size_t total = 0;
+        for (auto b : bytes)
+            total += b;
+        EXPECT_EQ(names.size() * 256 * 1024, total);
+        printf("%s zip, %zu threads: %.1f MB/s\n", mapped ? "mapped" : "default", numThreads,
+               total / seconds / (1024 * 1024));
+    }
+
+    factory.destroyInstance(zip);
+}
+
+TEST_F(ZipArchiveTests,OpenThroughput)
+{
+    String path = "OpenThroughput.zip";
+    StringVector names;
+    zip_t* zip = zip_open(path.c_str(), ZIP_DEFAULT_COMPRESSION_LEVEL, 'w');
+    String contents(256 * 1024, ' ');
+    uint32 seed = 1;
+    for (int i = 0; i < 64; i++)
+    {
+        // compressible, but not trivially
+        for (auto& c : contents)
+        {
+            seed = seed * 1664525 + 1013904223;
+            c = 'a' + (seed >> 28);
+        }
+        names.push_back("entry" + std::to_string(i) + ".bin");
+        zip_entry_open(zip, names.back().c_str(), 1);
+        zip_entry_write(zip, contents.data(), contents.size());
+        zip_entry_close(zip);
+    }
+    zip_close(zip);
+
+    benchmarkOpen(path, names, false);
+    benchmarkOpen(path, names, true);
+
+    std::remove(path.c_str());
+}
+//--------------------------------------------------------------------------